@@ -0,0 +1,471 @@
+#include "file_io.h"
+#include "image_processor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+
+using ImageProcessor::Image;
+using ImageProcessor::PixelLayout;
+
+// Construye una variante de la imagen de entrada con el número de canales y la
+// disposición pedidos (1: luminancia, 2: luminancia + alfa, 3: RGB, 4: RGBA)
+static void makeVariant(const Image &source, int channels, PixelLayout layout, Image &out)
+{
+    Image interleaved;
+    interleaved.width    = source.width;
+    interleaved.height   = source.height;
+    interleaved.channels = channels;
+    interleaved.allocateMemory(false);
+
+    for (int y = 0; y < source.height; y++) {
+        for (int x = 0; x < source.width; x++) {
+            const unsigned char *in = source.pixel(x, y);
+            unsigned char *px = interleaved.pixel(x, y);
+            unsigned char luma = static_cast<unsigned char>((in[0] * 77 + in[1] * 150 + in[2] * 29) >> 8);
+
+            switch (channels) {
+                case 1: px[0] = luma; break;
+                case 2: px[0] = luma; px[1] = 255; break;
+                case 3: memcpy(px, in, 3); break;
+                default: memcpy(px, in, 3); px[3] = 255; break;
+            }
+        }
+    }
+
+    interleaved.setLayout(layout);
+    out = std::move(interleaved);
+}
+
+// Tiempo medio en ms de una operación tras una pasada de calentamiento
+template <typename Operation>
+static double timeOperation(Operation operation, int repetitions)
+{
+    operation();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        operation();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+}
+
+// Rotación y escalado sobre RGB y RGBA en disposición intercalada y planar
+static void benchmarkLayouts(const Image &source, int repetitions)
+{
+    std::cout << "== Disposición intercalada vs planar ==" << std::endl;
+    std::cout << std::left << std::setw(10) << "Canales" << std::setw(14) << "Disposición"
+              << std::setw(16) << "Rotar 30° (ms)" << std::setw(16) << "Escalar 1.5 (ms)" << std::endl;
+
+    const int channelCounts[] = {3, 4};
+    const PixelLayout layouts[] = {PixelLayout::Interleaved, PixelLayout::Planar};
+
+    for (int channels : channelCounts) {
+        for (PixelLayout layout : layouts) {
+            Image input, rotated, scaled;
+            makeVariant(source, channels, layout, input);
+
+            double rotateMs = timeOperation([&]() { input.rotateTo(rotated, 30.0f); }, repetitions);
+            double scaleMs  = timeOperation([&]() { input.scaleTo(scaled, 1.5f); }, repetitions);
+
+            std::cout << std::left << std::setw(10) << (channels == 3 ? "RGB" : "RGBA")
+                      << std::setw(14) << (layout == PixelLayout::Planar ? "planar" : "intercalada")
+                      << std::fixed << std::setprecision(2)
+                      << std::setw(16) << rotateMs << std::setw(16) << scaleMs << std::endl;
+        }
+    }
+}
+
+// Rotación y escalado para 1, 2, 3 y 4 canales (disposición intercalada); cada
+// número de canales usa su propio kernel especializado
+static void benchmarkChannels(const Image &source, int repetitions)
+{
+    const char *names[] = {"", "Gris", "Gris+alfa", "RGB", "RGBA"};
+
+    std::cout << "== Kernels por número de canales ==" << std::endl;
+    std::cout << std::left << std::setw(12) << "Canales" << std::setw(16) << "Rotar 30° (ms)"
+              << std::setw(16) << "Escalar 1.5 (ms)" << std::setw(16) << "ns/muestra" << std::endl;
+
+    for (int channels = 1; channels <= 4; channels++) {
+        Image input, rotated, scaled;
+        makeVariant(source, channels, PixelLayout::Interleaved, input);
+
+        double rotateMs = timeOperation([&]() { input.rotateTo(rotated, 30.0f); }, repetitions);
+        double scaleMs  = timeOperation([&]() { input.scaleTo(scaled, 1.5f); }, repetitions);
+        double samples  = (double)input.width * input.height * channels;
+
+        std::cout << std::left << std::setw(12) << names[channels] << std::fixed << std::setprecision(2)
+                  << std::setw(16) << rotateMs << std::setw(16) << scaleMs
+                  << std::setw(16) << (rotateMs * 1e6 / samples) << std::endl;
+    }
+}
+
+// Rotación a varios ángulos con la imagen por filas y en teselas (32 y 64, por
+// filas y en orden Z), más el coste de convertir desde y hacia líneas de barrido
+static void benchmarkTiles(const Image &source, int repetitions)
+{
+    struct Variant
+    {
+        const char *name;
+        PixelLayout layout;
+        int tileSize;
+    };
+
+    const Variant variants[] = {
+        {"filas",       PixelLayout::Interleaved, 0},
+        {"teselas 32",  PixelLayout::Tiled,       32},
+        {"teselas 64",  PixelLayout::Tiled,       64},
+        {"morton 32",   PixelLayout::TiledMorton, 32},
+        {"morton 64",   PixelLayout::TiledMorton, 64},
+    };
+    const float angles[] = {0.0f, 5.0f, 15.0f, 30.0f, 45.0f, 60.0f, 90.0f, 135.0f};
+
+    std::cout << "== Rotación: líneas de barrido vs teselas (RGB, ms) ==" << std::endl;
+    std::cout << std::left << std::setw(13) << "Disposición" << std::setw(14) << "Conversión";
+    for (float angle : angles) {
+        std::cout << std::setw(8) << (std::to_string(static_cast<int>(angle)) + "°");
+    }
+    std::cout << std::endl;
+
+    for (const Variant &variant : variants) {
+        Image input, rotated;
+        makeVariant(source, 3, PixelLayout::Interleaved, input);
+
+        // Ida y vuelta entre líneas de barrido y la disposición probada (lo que
+        // cuesta en carga y guardado)
+        double convertMs = 0.0;
+        if (variant.tileSize > 0) {
+            Image scanlines = input;
+            convertMs = timeOperation([&]() {
+                scanlines.setLayout(variant.layout, variant.tileSize);
+                scanlines.setLayout(PixelLayout::Interleaved);
+            }, repetitions);
+            input.setLayout(variant.layout, variant.tileSize);
+        }
+
+        // Medir todos los ángulos antes de imprimir la fila: las reservas de memoria
+        // también escriben en la salida
+        double rotateMs[sizeof(angles) / sizeof(angles[0])];
+        for (size_t a = 0; a < sizeof(angles) / sizeof(angles[0]); a++) {
+            rotateMs[a] = timeOperation([&]() { input.rotateTo(rotated, angles[a]); }, repetitions);
+        }
+
+        std::cout << std::left << std::setw(13) << variant.name << std::fixed << std::setprecision(2)
+                  << std::setw(14) << convertMs;
+        for (double ms : rotateMs) {
+            std::cout << std::setw(8) << ms;
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Diferencia máxima entre dos imágenes intercaladas de la misma geometría
+static int maxDifference(const Image &a, const Image &b)
+{
+    int maxDiff = 0;
+    for (int y = 0; y < a.height; y++) {
+        for (int x = 0; x < a.width * a.channels; x++) {
+            maxDiff = std::max(maxDiff, std::abs(a.row(y)[x] - b.row(y)[x]));
+        }
+    }
+    return maxDiff;
+}
+
+// Diferencia media por muestra entre dos imágenes intercaladas de la misma geometría
+static double meanDifference(const Image &a, const Image &b)
+{
+    double total = 0.0;
+    for (int y = 0; y < a.height; y++) {
+        for (int x = 0; x < a.width * a.channels; x++) {
+            total += std::abs(a.row(y)[x] - b.row(y)[x]);
+        }
+    }
+    return total / ((double)a.width * a.height * a.channels);
+}
+
+// Interpolación con pesos enteros frente a la ruta en float (rotar y escalar a la
+// vez), con la diferencia máxima entre ambas salidas
+static void benchmarkInteger(const Image &source, int repetitions)
+{
+    const char *names[] = {"", "Gris", "Gris+alfa", "RGB", "RGBA"};
+
+    std::cout << "== Interpolación entera vs float (rotar 30° + escalar 1.5) ==" << std::endl;
+    std::cout << std::left << std::setw(12) << "Canales" << std::setw(14) << "Float (ms)"
+              << std::setw(14) << "Entera (ms)" << std::setw(14) << "Dif. máxima" << std::endl;
+
+    for (int channels = 1; channels <= 4; channels++) {
+        Image input, floatOutput, integerOutput;
+        makeVariant(source, channels, PixelLayout::Interleaved, input);
+
+        ImageProcessor::ImageBase::useIntegerInterpolation = false;
+        double floatMs = timeOperation([&]() { input.rotateScaleTo(floatOutput, 30.0f, 1.5f); }, repetitions);
+        ImageProcessor::ImageBase::useIntegerInterpolation = true;
+        double integerMs = timeOperation([&]() { input.rotateScaleTo(integerOutput, 30.0f, 1.5f); }, repetitions);
+
+        std::cout << std::left << std::setw(12) << names[channels] << std::fixed << std::setprecision(2)
+                  << std::setw(14) << floatMs << std::setw(14) << integerMs
+                  << std::setw(14) << maxDifference(floatOutput, integerOutput) << std::endl;
+    }
+}
+
+// Miniaturas (reducción a 1/10): muestreo bilineal de cuatro vecinos frente al
+// promedio de área, directo o desde una pirámide de mipmaps ya construida
+static void benchmarkThumbnails(const Image &source, int repetitions)
+{
+    const float factor = 0.1f;
+    const int outWidth = static_cast<int>(source.width * factor);
+    const int outHeight = static_cast<int>(source.height * factor);
+
+    std::cout << "== Miniatura " << outWidth << " x " << outHeight << " (factor " << factor << ") ==" << std::endl;
+    std::cout << std::left << std::setw(28) << "Método" << std::setw(14) << "Tiempo (ms)" << std::endl;
+
+    Image bilinearOutput, areaOutput, pyramidOutput;
+    bilinearOutput.width = outWidth;
+    bilinearOutput.height = outHeight;
+    bilinearOutput.channels = source.channels;
+    bilinearOutput.allocateMemory(false);
+
+    double bilinearMs = timeOperation([&]() {
+        ImageProcessor::warpAffine(source.view(), bilinearOutput.view(),
+                                   ImageProcessor::AffineTransform::scaling(factor, factor));
+    }, repetitions);
+    double areaMs = timeOperation([&]() { source.resizeTo(areaOutput, outWidth, outHeight); }, repetitions);
+
+    ImageProcessor::MipPyramid pyramid;
+    double buildMs = timeOperation([&]() { pyramid.build(source); }, repetitions);
+    double pyramidMs = timeOperation([&]() { pyramid.resizeTo(pyramidOutput, outWidth, outHeight); }, repetitions);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(28) << "Bilineal (warpAffine)" << std::setw(14) << bilinearMs << std::endl
+              << std::setw(28) << "Área directa" << std::setw(14) << areaMs << std::endl
+              << std::setw(28) << "Construir pirámide" << std::setw(14) << buildMs << std::endl
+              << std::setw(28) << "Área desde la pirámide" << std::setw(14) << pyramidMs << std::endl;
+    std::cout << "Dif. máxima área directa / pirámide: " << maxDifference(areaOutput, pyramidOutput) << std::endl;
+}
+
+// Kernels vectoriales por juego de instrucciones (hasta el que detecta la CPU)
+// frente a la ruta escalar; la diferencia con la salida escalar debe ser 0
+static void benchmarkSimd(const Image &source, int repetitions)
+{
+    using BilinearSimd::Level;
+    const Level detected = ImageProcessor::ImageBase::simdLevel;
+    const Level levels[] = {Level::Scalar, Level::SSE41, Level::AVX2, Level::AVX512};
+
+    std::cout << "== Kernels vectoriales (rotar 30° + escalar 1.5, detectado: "
+              << BilinearSimd::levelName(detected) << ") ==" << std::endl;
+    std::cout << std::left << std::setw(12) << "Canales" << std::setw(12) << "Nivel"
+              << std::setw(14) << "Tiempo (ms)" << std::setw(14) << "Dif. máxima" << std::endl;
+
+    for (int channels = 3; channels <= 4; channels++) {
+        Image input, scalarOutput, output;
+        makeVariant(source, channels, PixelLayout::Interleaved, input);
+
+        for (Level level : levels) {
+            if (level > detected) {
+                break;
+            }
+            ImageProcessor::ImageBase::simdLevel = level;
+            Image &target = (level == Level::Scalar) ? scalarOutput : output;
+            double ms = timeOperation([&]() { input.rotateScaleTo(target, 30.0f, 1.5f); }, repetitions);
+
+            std::cout << std::left << std::setw(12) << (channels == 3 ? "RGB" : "RGBA")
+                      << std::setw(12) << BilinearSimd::levelName(level) << std::fixed << std::setprecision(2)
+                      << std::setw(14) << ms << std::setw(14) << maxDifference(scalarOutput, target) << std::endl;
+        }
+    }
+
+    ImageProcessor::ImageBase::simdLevel = detected;
+}
+
+// Filtros de remuestreo (vecino más cercano, bilineal, bicúbico, Lanczos-3) en
+// rotación y escalado, con la ruta entera y la ruta en float
+static void benchmarkFilters(const Image &source, int repetitions)
+{
+    using ImageProcessor::ResampleFilter;
+    const ResampleFilter filters[] = {ResampleFilter::Nearest, ResampleFilter::Bilinear, ResampleFilter::Bicubic,
+                                      ResampleFilter::Lanczos3};
+
+    std::cout << "== Filtros de remuestreo (RGB) ==" << std::endl;
+    std::cout << std::left << std::setw(12) << "Filtro" << std::setw(18) << "Rotar 30° (ms)"
+              << std::setw(18) << "Escalar 1.5 (ms)" << std::setw(18) << "Escalar 0.4 (ms)"
+              << std::setw(14) << "Dif. float" << std::endl;
+
+    Image output, floatOutput;
+    for (ResampleFilter filter : filters) {
+        double rotateMs = timeOperation([&]() { source.rotateTo(output, 30.0f, filter); }, repetitions);
+        double upMs = timeOperation([&]() { source.scaleTo(output, 1.5f, filter); }, repetitions);
+        double downMs = timeOperation([&]() { source.scaleTo(output, 0.4f, filter); }, repetitions);
+
+        // Diferencia entre las rutas entera y float al escalar 1.5
+        source.scaleTo(output, 1.5f, filter);
+        ImageProcessor::ImageBase::useIntegerInterpolation = false;
+        source.scaleTo(floatOutput, 1.5f, filter);
+        ImageProcessor::ImageBase::useIntegerInterpolation = true;
+
+        std::cout << std::left << std::setw(12) << ImageProcessor::filterName(filter) << std::fixed
+                  << std::setprecision(2) << std::setw(18) << rotateMs << std::setw(18) << upMs
+                  << std::setw(18) << downMs << std::setw(14) << maxDifference(output, floatOutput) << std::endl;
+    }
+}
+
+// Vecino más cercano frente a bilineal al escalar: ampliaciones enteras (repetición
+// de píxeles), una ampliación no entera (tabla de columnas) y una reducción
+static void benchmarkNearest(const Image &source, int repetitions)
+{
+    using ImageProcessor::ResampleFilter;
+    const float factors[] = {2.0f, 3.0f, 4.0f, 2.5f, 0.5f};
+
+    std::cout << "== Vecino más cercano vs bilineal al escalar (RGB) ==" << std::endl;
+    std::cout << std::left << std::setw(10) << "Factor" << std::setw(16) << "Vecino (ms)" << std::setw(18)
+              << "Bilineal (ms)" << std::setw(12) << "Mejora" << std::endl;
+
+    Image output;
+    for (float factor : factors) {
+        double nearestMs = timeOperation([&]() { source.scaleTo(output, factor, ResampleFilter::Nearest); },
+                                         repetitions);
+        double bilinearMs = timeOperation([&]() { source.scaleTo(output, factor, ResampleFilter::Bilinear); },
+                                          repetitions);
+
+        std::cout << std::left << std::fixed << std::setprecision(2) << std::setw(10) << factor
+                  << std::setw(16) << nearestMs << std::setw(18) << bilinearMs
+                  << std::setw(12) << (bilinearMs / nearestMs) << std::endl;
+    }
+}
+
+// Giros exactos de 90/180/270 grados y volteos frente a copiar la imagen
+// (memcpy) y frente a la rotación bilineal de 90 grados por warpAffine
+static void benchmarkRightAngles(const Image &source, int repetitions)
+{
+    std::cout << "== Giros exactos y volteos (RGB) ==" << std::endl;
+    std::cout << std::left << std::setw(26) << "Operación" << std::setw(14) << "Tiempo (ms)" << std::endl;
+
+    Image output, copy;
+    copy.width = source.width;
+    copy.height = source.height;
+    copy.channels = source.channels;
+    copy.allocateMemory(false);
+
+    auto report = [&](const char *name, double ms) {
+        std::cout << std::left << std::setw(26) << name << std::fixed << std::setprecision(3)
+                  << std::setw(14) << ms << std::endl;
+    };
+
+    report("Copia (memcpy)", timeOperation([&]() {
+        memcpy(copy.pixels(), source.pixels(), source.stride * source.height * sizeof(unsigned char));
+    }, repetitions));
+    report("Girar 90", timeOperation([&]() { source.rotateTo(output, 90.0f); }, repetitions));
+    report("Girar 180", timeOperation([&]() { source.rotateTo(output, 180.0f); }, repetitions));
+    report("Girar 270", timeOperation([&]() { source.rotateTo(output, 270.0f); }, repetitions));
+    report("Volteo horizontal", timeOperation([&]() { source.flipTo(output, true, false); }, repetitions));
+    report("Volteo vertical", timeOperation([&]() { source.flipTo(output, false, true); }, repetitions));
+    report("Bilineal 90 (warpAffine)", timeOperation([&]() {
+        ImageProcessor::rotate(source.view(), copy.view(), 90.0f);
+    }, repetitions));
+}
+
+// Rotación por tres cizallas frente a la directa (warpAffine) según el ángulo y
+// el tamaño de la imagen, y con los filtros bicúbico y Lanczos-3. Las salidas
+// difieren sobre todo en los bordes (suavizados con las cizallas).
+static void benchmarkShear(const Image &source, int repetitions)
+{
+    using ImageProcessor::ImageBase;
+    using ImageProcessor::ResampleFilter;
+    using ImageProcessor::RotationEngine;
+    const float angles[] = {10.0f, 30.0f, 45.0f, 100.0f};
+
+    std::cout << "== Rotación directa vs tres cizallas (RGB) ==" << std::endl;
+    std::cout << std::left << std::setw(14) << "Tamaño" << std::setw(12) << "Filtro" << std::setw(10) << "Ángulo"
+              << std::setw(14) << "Directa (ms)" << std::setw(16) << "Cizallas (ms)" << std::setw(14) << "Dif. media"
+              << std::endl;
+
+    auto compare = [&](const Image &input, float angle, ResampleFilter filter, int runs) {
+        Image direct, shear;
+        ImageBase::rotationEngine = RotationEngine::Direct;
+        double directMs = timeOperation([&]() { input.rotateTo(direct, angle, filter); }, runs);
+        ImageBase::rotationEngine = RotationEngine::Shear;
+        double shearMs = timeOperation([&]() { input.rotateTo(shear, angle, filter); }, runs);
+
+        std::cout << std::left << std::setw(14) << (std::to_string(input.width) + "x" + std::to_string(input.height))
+                  << std::setw(12) << ImageProcessor::filterName(filter)
+                  << std::setw(10) << (std::to_string(static_cast<int>(angle)) + "°") << std::fixed
+                  << std::setprecision(2) << std::setw(14) << directMs << std::setw(16) << shearMs
+                  << std::setw(14) << meanDifference(direct, shear) << std::endl;
+    };
+
+    for (int factor = 1; factor <= 3; factor++) {
+        Image input;
+        source.resizeTo(input, source.width * factor, source.height * factor);
+        const int runs = std::max(1, repetitions / (factor * factor));
+        for (float angle : angles) {
+            compare(input, angle, ResampleFilter::Bilinear, runs);
+        }
+    }
+    compare(source, 30.0f, ResampleFilter::Bicubic, repetitions);
+    compare(source, 30.0f, ResampleFilter::Lanczos3, repetitions);
+
+    ImageBase::rotationEngine = RotationEngine::Direct;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string inputFile = (argc > 1) ? argv[1] : "prueba3.jpg";
+    int repetitions       = (argc > 2) ? std::max(1, atoi(argv[2])) : 10;
+    std::string suite     = (argc > 3) ? argv[3] : "todas"; // todas | disposicion | canales | teselas | entera | simd | miniatura | filtros | vecino | giros | cizalla
+
+    Image source;
+    if (!FileIO::loadImage(inputFile, source) || source.channels < 3) {
+        std::cerr << "Se necesita una imagen RGB de entrada: " << inputFile << std::endl;
+        return 1;
+    }
+
+    std::cout << "Imagen: " << inputFile << " (" << source.width << " x " << source.height << "), "
+              << repetitions << " repeticiones" << std::endl;
+
+    if (suite == "todas" || suite == "disposicion") {
+        benchmarkLayouts(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "canales") {
+        benchmarkChannels(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "teselas") {
+        benchmarkTiles(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "entera") {
+        benchmarkInteger(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "simd") {
+        benchmarkSimd(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "miniatura") {
+        benchmarkThumbnails(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "filtros") {
+        benchmarkFilters(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "vecino") {
+        benchmarkNearest(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "giros") {
+        benchmarkRightAngles(source, repetitions);
+    }
+
+    if (suite == "todas" || suite == "cizalla") {
+        benchmarkShear(source, repetitions);
+    }
+
+    return 0;
+}
@@ -0,0 +1,419 @@
+#include "bilinear_simd.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BILINEAR_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace BilinearSimd
+{
+    // Pesos de la ruta entera de 8 bits: fracción 16.16 redondeada a 8 bits
+    static const int FRACTION_DROP = 8;
+    static const int32_t WEIGHT_ONE = 256;
+
+    // Píxel de referencia: misma aritmética que bilinearTapsInteger para uint8_t
+    static inline void referencePixel(const uint8_t* src, int stride, int width, int height, int channels,
+                                      int32_t fx, int32_t fy, uint8_t* out)
+    {
+        const int32_t x1 = fx >> 16;
+        const int32_t y1 = fy >> 16;
+
+        if (fx < 0 || fy < 0 || x1 >= width - 1 || y1 >= height - 1) {
+            for (int c = 0; c < channels; c++) {
+                out[c] = 0;
+            }
+            return;
+        }
+
+        const uint32_t half = (1u << FRACTION_DROP) >> 1;
+        const uint32_t wx = ((fx & 0xffff) + half) >> FRACTION_DROP;
+        const uint32_t wy = ((fy & 0xffff) + half) >> FRACTION_DROP;
+
+        const uint8_t* p00 = src + (size_t)y1 * stride + (size_t)x1 * channels;
+        const uint8_t* p10 = p00 + channels;
+        const uint8_t* p01 = p00 + stride;
+        const uint8_t* p11 = p01 + channels;
+
+        for (int c = 0; c < channels; c++) {
+            uint32_t top    = p00[c] * (WEIGHT_ONE - wx) + p10[c] * wx;
+            uint32_t bottom = p01[c] * (WEIGHT_ONE - wx) + p11[c] * wx;
+            out[c] = static_cast<uint8_t>((top * (WEIGHT_ONE - wy) + bottom * wy) >> 16);
+        }
+    }
+
+    void referenceRow(const uint8_t* src, int stride, int width, int height, int channels,
+                      int32_t fx, int32_t fy, int32_t stepX, int32_t stepY, int n, uint8_t* out)
+    {
+        for (int i = 0; i < n; i++, fx += stepX, fy += stepY, out += channels) {
+            referencePixel(src, stride, width, height, channels, fx, fy, out);
+        }
+    }
+
+#if defined(BILINEAR_SIMD_X86)
+
+    // Máscaras de pshufb (iguales en cada carril de 128 bits) usadas por los kernels
+    // para separar y volver a juntar canales sin desplazamientos por canal:
+    //   lo[c]:    byte c del píxel p00 -> byte 0 de su palabra de 32 bits
+    //   hi[c]:    byte c del píxel p10 -> byte 2 (par de 16 bits para pmaddwd)
+    //   place[c]: byte 0 (canal interpolado) -> byte c
+    //   pack3:    junta los 3 primeros bytes de cada palabra (RGB sin relleno)
+    struct ShuffleMasks
+    {
+        int8_t lo[4][16];
+        int8_t hi[4][16];
+        int8_t place[4][16];
+        int8_t pack3[16];
+
+        explicit ShuffleMasks(int rightOffset)
+        {
+            for (int c = 0; c < 4; c++) {
+                for (int i = 0; i < 16; i++) {
+                    int word = i / 4 * 4, byte = i % 4;
+                    lo[c][i]    = (byte == 0) ? (int8_t)(word + c) : (int8_t)-128;
+                    hi[c][i]    = (byte == 2) ? (int8_t)(word + c + rightOffset) : (int8_t)-128;
+                    place[c][i] = (byte == c) ? (int8_t)word : (int8_t)-128;
+                }
+            }
+            for (int i = 0; i < 16; i++) {
+                pack3[i] = (i < 12) ? (int8_t)(i / 3 * 4 + i % 3) : (int8_t)-128;
+            }
+        }
+    };
+
+    // Construidas una sola vez: los kernels se llaman por cada fila de un bloque
+    static const ShuffleMasks masksRgb(1);
+    static const ShuffleMasks masksRgba(0);
+
+    // Con 3 canales p10 se lee desde el último byte de p00 (4 bytes sin pasarse del
+    // final de la fila) y sus canales empiezan en el byte 1
+    template <int C>
+    static inline int rightFetchOffset() { return C == 3 ? C - 1 : C; }
+
+    static inline int32_t load32(const uint8_t* p)
+    {
+        int32_t value;
+        memcpy(&value, p, 4);
+        return value;
+    }
+
+    // SSE4.1: 4 píxeles por iteración, vecinos cargados con lecturas escalares de
+    // 32 bits (sin gathers) y canales separados con pshufb
+    template <int C>
+    __attribute__((target("sse4.1")))
+    static void rowSse41(const uint8_t* src, int stride, int width, int height,
+                         int32_t fx, int32_t fy, int32_t stepX, int32_t stepY, int n, uint8_t* out)
+    {
+        const int right = rightFetchOffset<C>();
+        const ShuffleMasks &masks = (C == 3) ? masksRgb : masksRgba;
+        __m128i lo[C], hi[C], place[C];
+        for (int c = 0; c < C; c++) {
+            lo[c]    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.lo[c]));
+            hi[c]    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.hi[c]));
+            place[c] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.place[c]));
+        }
+        const __m128i pack3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.pack3));
+
+        const __m128i lanes    = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i minusOne = _mm_set1_epi32(-1);
+        const __m128i maxX     = _mm_set1_epi32(width - 1);
+        const __m128i maxY     = _mm_set1_epi32(height - 1);
+        const __m128i fracMask = _mm_set1_epi32(0xffff);
+        const __m128i half     = _mm_set1_epi32((1 << FRACTION_DROP) >> 1);
+        const __m128i one      = _mm_set1_epi32(WEIGHT_ONE);
+        const __m128i vstride  = _mm_set1_epi32(stride);
+        const __m128i vchannels = _mm_set1_epi32(C);
+        const __m128i stepX4   = _mm_set1_epi32(stepX * 4);
+        const __m128i stepY4   = _mm_set1_epi32(stepY * 4);
+
+        __m128i vfx = _mm_add_epi32(_mm_set1_epi32(fx), _mm_mullo_epi32(lanes, _mm_set1_epi32(stepX)));
+        __m128i vfy = _mm_add_epi32(_mm_set1_epi32(fy), _mm_mullo_epi32(lanes, _mm_set1_epi32(stepY)));
+
+        int i = 0;
+        for (; i + 4 <= n; i += 4, out += 4 * C) {
+            __m128i inside = _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi32(vfx, minusOne), _mm_cmpgt_epi32(vfy, minusOne)),
+                                           _mm_and_si128(_mm_cmpgt_epi32(maxX, _mm_srai_epi32(vfx, 16)),
+                                                         _mm_cmpgt_epi32(maxY, _mm_srai_epi32(vfy, 16))));
+
+            // Fuera de la imagen se lee el píxel (0, 0) y el resultado se anula al final
+            __m128i px = _mm_and_si128(vfx, inside);
+            __m128i py = _mm_and_si128(vfy, inside);
+            __m128i offset = _mm_add_epi32(_mm_mullo_epi32(_mm_srai_epi32(py, 16), vstride),
+                                           _mm_mullo_epi32(_mm_srai_epi32(px, 16), vchannels));
+            __m128i wx = _mm_srli_epi32(_mm_add_epi32(_mm_and_si128(px, fracMask), half), FRACTION_DROP);
+            __m128i wy = _mm_srli_epi32(_mm_add_epi32(_mm_and_si128(py, fracMask), half), FRACTION_DROP);
+
+            alignas(16) int32_t offsets[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(offsets), offset);
+            const uint8_t* p0 = src + offsets[0];
+            const uint8_t* p1 = src + offsets[1];
+            const uint8_t* p2 = src + offsets[2];
+            const uint8_t* p3 = src + offsets[3];
+            __m128i g00 = _mm_setr_epi32(load32(p0), load32(p1), load32(p2), load32(p3));
+            __m128i g10 = _mm_setr_epi32(load32(p0 + right), load32(p1 + right), load32(p2 + right), load32(p3 + right));
+            __m128i g01 = _mm_setr_epi32(load32(p0 + stride), load32(p1 + stride), load32(p2 + stride), load32(p3 + stride));
+            __m128i g11 = _mm_setr_epi32(load32(p0 + stride + right), load32(p1 + stride + right),
+                                         load32(p2 + stride + right), load32(p3 + stride + right));
+
+            // Pesos horizontales como pares de 16 bits (1 - wx, wx) para pmaddwd
+            __m128i wxPair = _mm_or_si128(_mm_sub_epi32(one, wx), _mm_slli_epi32(wx, 16));
+            __m128i wyInv  = _mm_sub_epi32(one, wy);
+
+            __m128i result = _mm_setzero_si128();
+            for (int c = 0; c < C; c++) {
+                __m128i top    = _mm_madd_epi16(_mm_or_si128(_mm_shuffle_epi8(g00, lo[c]), _mm_shuffle_epi8(g10, hi[c])), wxPair);
+                __m128i bottom = _mm_madd_epi16(_mm_or_si128(_mm_shuffle_epi8(g01, lo[c]), _mm_shuffle_epi8(g11, hi[c])), wxPair);
+                __m128i value  = _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi32(top, wyInv), _mm_mullo_epi32(bottom, wy)), 16);
+                result = _mm_or_si128(result, _mm_shuffle_epi8(value, place[c]));
+            }
+            result = _mm_and_si128(result, inside);
+
+            if (C == 4) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+            } else {
+                result = _mm_shuffle_epi8(result, pack3);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out), result);
+                int32_t last = _mm_extract_epi32(result, 2);
+                memcpy(out + 8, &last, 4);
+            }
+
+            vfx = _mm_add_epi32(vfx, stepX4);
+            vfy = _mm_add_epi32(vfy, stepY4);
+        }
+
+        referenceRow(src, stride, width, height, C, fx + i * stepX, fy + i * stepY, stepX, stepY, n - i, out);
+    }
+
+    // AVX2: 8 píxeles por iteración con gathers de 32 bits para los cuatro vecinos
+    template <int C>
+    __attribute__((target("avx2")))
+    static void rowAvx2(const uint8_t* src, int stride, int width, int height,
+                        int32_t fx, int32_t fy, int32_t stepX, int32_t stepY, int n, uint8_t* out)
+    {
+        const int right = rightFetchOffset<C>();
+        const ShuffleMasks &masks = (C == 3) ? masksRgb : masksRgba;
+        __m256i lo[C], hi[C], place[C];
+        for (int c = 0; c < C; c++) {
+            lo[c]    = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.lo[c])));
+            hi[c]    = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.hi[c])));
+            place[c] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.place[c])));
+        }
+        const __m256i pack3    = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.pack3)));
+        const __m256i compact3 = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+        const __m256i lanes    = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i minusOne = _mm256_set1_epi32(-1);
+        const __m256i maxX     = _mm256_set1_epi32(width - 1);
+        const __m256i maxY     = _mm256_set1_epi32(height - 1);
+        const __m256i fracMask = _mm256_set1_epi32(0xffff);
+        const __m256i half     = _mm256_set1_epi32((1 << FRACTION_DROP) >> 1);
+        const __m256i one      = _mm256_set1_epi32(WEIGHT_ONE);
+        const __m256i vstride  = _mm256_set1_epi32(stride);
+        const __m256i vchannels = _mm256_set1_epi32(C);
+        const __m256i stepX8   = _mm256_set1_epi32(stepX * 8);
+        const __m256i stepY8   = _mm256_set1_epi32(stepY * 8);
+
+        const int* base00 = reinterpret_cast<const int*>(src);
+        const int* base10 = reinterpret_cast<const int*>(src + right);
+        const int* base01 = reinterpret_cast<const int*>(src + stride);
+        const int* base11 = reinterpret_cast<const int*>(src + stride + right);
+
+        __m256i vfx = _mm256_add_epi32(_mm256_set1_epi32(fx), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(stepX)));
+        __m256i vfy = _mm256_add_epi32(_mm256_set1_epi32(fy), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(stepY)));
+
+        int i = 0;
+        for (; i + 8 <= n; i += 8, out += 8 * C) {
+            __m256i inside = _mm256_and_si256(
+                _mm256_and_si256(_mm256_cmpgt_epi32(vfx, minusOne), _mm256_cmpgt_epi32(vfy, minusOne)),
+                _mm256_and_si256(_mm256_cmpgt_epi32(maxX, _mm256_srai_epi32(vfx, 16)),
+                                 _mm256_cmpgt_epi32(maxY, _mm256_srai_epi32(vfy, 16))));
+
+            // Fuera de la imagen se lee el píxel (0, 0) y el resultado se anula al final
+            __m256i px = _mm256_and_si256(vfx, inside);
+            __m256i py = _mm256_and_si256(vfy, inside);
+            __m256i offset = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_srai_epi32(py, 16), vstride),
+                                              _mm256_mullo_epi32(_mm256_srai_epi32(px, 16), vchannels));
+            __m256i wx = _mm256_srli_epi32(_mm256_add_epi32(_mm256_and_si256(px, fracMask), half), FRACTION_DROP);
+            __m256i wy = _mm256_srli_epi32(_mm256_add_epi32(_mm256_and_si256(py, fracMask), half), FRACTION_DROP);
+
+            __m256i g00 = _mm256_i32gather_epi32(base00, offset, 1);
+            __m256i g10 = _mm256_i32gather_epi32(base10, offset, 1);
+            __m256i g01 = _mm256_i32gather_epi32(base01, offset, 1);
+            __m256i g11 = _mm256_i32gather_epi32(base11, offset, 1);
+
+            // Pesos horizontales como pares de 16 bits (1 - wx, wx) para pmaddwd
+            __m256i wxPair = _mm256_or_si256(_mm256_sub_epi32(one, wx), _mm256_slli_epi32(wx, 16));
+            __m256i wyInv  = _mm256_sub_epi32(one, wy);
+
+            __m256i result = _mm256_setzero_si256();
+            for (int c = 0; c < C; c++) {
+                __m256i top = _mm256_madd_epi16(
+                    _mm256_or_si256(_mm256_shuffle_epi8(g00, lo[c]), _mm256_shuffle_epi8(g10, hi[c])), wxPair);
+                __m256i bottom = _mm256_madd_epi16(
+                    _mm256_or_si256(_mm256_shuffle_epi8(g01, lo[c]), _mm256_shuffle_epi8(g11, hi[c])), wxPair);
+                __m256i value = _mm256_srli_epi32(
+                    _mm256_add_epi32(_mm256_mullo_epi32(top, wyInv), _mm256_mullo_epi32(bottom, wy)), 16);
+                result = _mm256_or_si256(result, _mm256_shuffle_epi8(value, place[c]));
+            }
+            result = _mm256_and_si256(result, inside);
+
+            if (C == 4) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), result);
+            } else {
+                // 12 bytes útiles por carril de 128 bits: juntarlos en los 24 primeros
+                result = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(result, pack3), compact3);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(result));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out + 16), _mm256_extracti128_si256(result, 1));
+            }
+
+            vfx = _mm256_add_epi32(vfx, stepX8);
+            vfy = _mm256_add_epi32(vfy, stepY8);
+        }
+
+        referenceRow(src, stride, width, height, C, fx + i * stepX, fy + i * stepY, stepX, stepY, n - i, out);
+    }
+
+    // GCC 12 avisa de _mm512_undefined_epi32 (inicialización de sí mismo) al
+    // expandir los intrínsecos de AVX-512; el aviso no aplica
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+    // AVX-512 (F + BW): 16 píxeles por iteración, gathers de 32 bits y máscaras de
+    // predicado para los píxeles fuera de la imagen
+    template <int C>
+    __attribute__((target("avx512f,avx512bw")))
+    static void rowAvx512(const uint8_t* src, int stride, int width, int height,
+                          int32_t fx, int32_t fy, int32_t stepX, int32_t stepY, int n, uint8_t* out)
+    {
+        const int right = rightFetchOffset<C>();
+        const ShuffleMasks &masks = (C == 3) ? masksRgb : masksRgba;
+        __m512i lo[C], hi[C], place[C];
+        for (int c = 0; c < C; c++) {
+            lo[c]    = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.lo[c])));
+            hi[c]    = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.hi[c])));
+            place[c] = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.place[c])));
+        }
+        const __m512i pack3    = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(masks.pack3)));
+        const __m512i compact3 = _mm512_setr_epi32(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, 15, 15, 15, 15);
+
+        const __m512i lanes    = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m512i minusOne = _mm512_set1_epi32(-1);
+        const __m512i maxX     = _mm512_set1_epi32(width - 1);
+        const __m512i maxY     = _mm512_set1_epi32(height - 1);
+        const __m512i fracMask = _mm512_set1_epi32(0xffff);
+        const __m512i half     = _mm512_set1_epi32((1 << FRACTION_DROP) >> 1);
+        const __m512i one      = _mm512_set1_epi32(WEIGHT_ONE);
+        const __m512i vstride  = _mm512_set1_epi32(stride);
+        const __m512i vchannels = _mm512_set1_epi32(C);
+        const __m512i stepX16  = _mm512_set1_epi32(stepX * 16);
+        const __m512i stepY16  = _mm512_set1_epi32(stepY * 16);
+
+        __m512i vfx = _mm512_add_epi32(_mm512_set1_epi32(fx), _mm512_mullo_epi32(lanes, _mm512_set1_epi32(stepX)));
+        __m512i vfy = _mm512_add_epi32(_mm512_set1_epi32(fy), _mm512_mullo_epi32(lanes, _mm512_set1_epi32(stepY)));
+
+        int i = 0;
+        for (; i + 16 <= n; i += 16, out += 16 * C) {
+            __mmask16 inside = _mm512_cmpgt_epi32_mask(vfx, minusOne) & _mm512_cmpgt_epi32_mask(vfy, minusOne) &
+                               _mm512_cmpgt_epi32_mask(maxX, _mm512_srai_epi32(vfx, 16)) &
+                               _mm512_cmpgt_epi32_mask(maxY, _mm512_srai_epi32(vfy, 16));
+
+            // Fuera de la imagen se lee el píxel (0, 0) y el resultado se anula al final
+            __m512i px = _mm512_maskz_mov_epi32(inside, vfx);
+            __m512i py = _mm512_maskz_mov_epi32(inside, vfy);
+            __m512i offset = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_srai_epi32(py, 16), vstride),
+                                              _mm512_mullo_epi32(_mm512_srai_epi32(px, 16), vchannels));
+            __m512i wx = _mm512_srli_epi32(_mm512_add_epi32(_mm512_and_si512(px, fracMask), half), FRACTION_DROP);
+            __m512i wy = _mm512_srli_epi32(_mm512_add_epi32(_mm512_and_si512(py, fracMask), half), FRACTION_DROP);
+
+            __m512i g00 = _mm512_i32gather_epi32(offset, src, 1);
+            __m512i g10 = _mm512_i32gather_epi32(offset, src + right, 1);
+            __m512i g01 = _mm512_i32gather_epi32(offset, src + stride, 1);
+            __m512i g11 = _mm512_i32gather_epi32(offset, src + stride + right, 1);
+
+            // Pesos horizontales como pares de 16 bits (1 - wx, wx) para pmaddwd
+            __m512i wxPair = _mm512_or_si512(_mm512_sub_epi32(one, wx), _mm512_slli_epi32(wx, 16));
+            __m512i wyInv  = _mm512_sub_epi32(one, wy);
+
+            __m512i result = _mm512_setzero_si512();
+            for (int c = 0; c < C; c++) {
+                __m512i top = _mm512_madd_epi16(
+                    _mm512_or_si512(_mm512_shuffle_epi8(g00, lo[c]), _mm512_shuffle_epi8(g10, hi[c])), wxPair);
+                __m512i bottom = _mm512_madd_epi16(
+                    _mm512_or_si512(_mm512_shuffle_epi8(g01, lo[c]), _mm512_shuffle_epi8(g11, hi[c])), wxPair);
+                __m512i value = _mm512_srli_epi32(
+                    _mm512_add_epi32(_mm512_mullo_epi32(top, wyInv), _mm512_mullo_epi32(bottom, wy)), 16);
+                result = _mm512_or_si512(result, _mm512_shuffle_epi8(value, place[c]));
+            }
+            result = _mm512_maskz_mov_epi32(inside, result);
+
+            if (C == 4) {
+                _mm512_storeu_si512(out, result);
+            } else {
+                // 12 bytes útiles por carril de 128 bits: juntarlos y guardar 48 bytes
+                result = _mm512_permutexvar_epi32(compact3, _mm512_shuffle_epi8(result, pack3));
+                _mm512_mask_storeu_epi32(out, 0x0fff, result);
+            }
+
+            vfx = _mm512_add_epi32(vfx, stepX16);
+            vfy = _mm512_add_epi32(vfy, stepY16);
+        }
+
+        referenceRow(src, stride, width, height, C, fx + i * stepX, fy + i * stepY, stepX, stepY, n - i, out);
+    }
+
+#pragma GCC diagnostic pop
+
+    Level detectLevel()
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return Level::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return Level::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return Level::SSE41;
+        }
+        return Level::Scalar;
+    }
+
+    RowKernel rowKernel(Level level, int channels)
+    {
+        if (channels != 3 && channels != 4) {
+            return nullptr;
+        }
+
+        switch (level) {
+            case Level::AVX512: return channels == 3 ? rowAvx512<3> : rowAvx512<4>;
+            case Level::AVX2:   return channels == 3 ? rowAvx2<3> : rowAvx2<4>;
+            case Level::SSE41:  return channels == 3 ? rowSse41<3> : rowSse41<4>;
+            default:            return nullptr;
+        }
+    }
+
+#else
+
+    Level detectLevel()
+    {
+        return Level::Scalar;
+    }
+
+    RowKernel rowKernel(Level, int)
+    {
+        return nullptr;
+    }
+
+#endif
+
+    const char* levelName(Level level)
+    {
+        switch (level) {
+            case Level::SSE41:  return "SSE4.1";
+            case Level::AVX2:   return "AVX2";
+            case Level::AVX512: return "AVX-512";
+            default:            return "escalar";
+        }
+    }
+} // namespace BilinearSimd
@@ -0,0 +1,47 @@
+#ifndef BILINEAR_SIMD_H
+#define BILINEAR_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Kernels vectoriales (SSE4.1, AVX2, AVX-512) de la interpolación bilineal de 8
+// bits con pesos enteros, elegidos en ejecución según la CPU. Los usa el kernel
+// afín (rotaciones y warpAffine); el escalado sin rotación pasa por resize
+namespace BilinearSimd
+{
+    // Niveles de instrucciones, de menor a mayor
+    enum class Level
+    {
+        Scalar,
+        SSE41,
+        AVX2,
+        AVX512
+    };
+
+    // Mejor nivel que soporta la CPU (CPUID); Scalar fuera de x86
+    Level detectLevel();
+
+    const char* levelName(Level level);
+
+    // Interpola una fila de n píxeles intercalados de 8 bits con 'channels' canales
+    // (3 o 4) a partir de posiciones de origen en coma fija 16.16: la del píxel i
+    // es (fx + i * stepX, fy + i * stepY). Los pesos y el redondeo son los de la
+    // ruta entera escalar, así que el resultado es idéntico bit a bit. Fuera de la
+    // imagen (sin los cuatro vecinos) escribe 0.
+    //
+    // Requisitos del llamador: width y height >= 2, height * stride < 2^31 y
+    // posiciones de toda la fila (y 16 pasos) representables en 32 bits.
+    typedef void (*RowKernel)(const uint8_t* src, int stride, int width, int height,
+                              int32_t fx, int32_t fy, int32_t stepX, int32_t stepY, int n, uint8_t* out);
+
+    // Kernel para el nivel y el número de canales pedidos; nullptr si no hay
+    // versión vectorial (el llamador usa su ruta escalar)
+    RowKernel rowKernel(Level level, int channels);
+
+    // Versión escalar de referencia con la misma firma (cualquier número de canales
+    // de 1 a 4), para comprobar los kernels vectoriales
+    void referenceRow(const uint8_t* src, int stride, int width, int height, int channels,
+                      int32_t fx, int32_t fy, int32_t stepX, int32_t stepY, int n, uint8_t* out);
+} // namespace BilinearSimd
+
+#endif // BILINEAR_SIMD_H
@@ -4,6 +4,9 @@
 #include <algorithm>
 #include <iomanip>
 #include <cstring> // Para memcpy/memset
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
 
 // Verificar si OpenMP está disponible
 #if defined(_OPENMP)
@@ -13,7 +16,15 @@
 namespace MemoryManagement 
 {
     BuddySystem::BuddySystem(size_t totalSize, size_t minBlockSize) 
-        : minBlockSize(minBlockSize)
+        : minBlockSize(minBlockSize),
+          allocatedCount(0),
+          usedBytes(0),
+          peakUsedBytes(0),
+          pageSize(static_cast<size_t>(sysconf(_SC_PAGESIZE))),
+          releasedBytes(0),
+          lazyFreedBytes(0),
+          trimStop(false),
+          lastActivity(std::chrono::steady_clock::now())
     {
         // Ajustar totalSize a la siguiente potencia de 2
         this->totalSize = 1;
@@ -31,25 +42,36 @@ namespace MemoryManagement
         
         // Inicializar las listas de bloques libres
         freeBlocks.resize(levels);
-        
-        // Asignar el pool de memoria e inicializarlo a cero para mejor rendimiento
-        memoryPool = new unsigned char[this->totalSize];
+        blockLevels.assign(this->totalSize / getSizeFromLevel(levels - 1), -1);
+        
+        // Asignar el pool con mmap (alineado a página, necesario para madvise)
+        // e inicializarlo a cero para mejor rendimiento
+        void* mapping = mmap(nullptr, this->totalSize, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        memoryPool = static_cast<unsigned char*>(mapping);
         memset(memoryPool, 0, this->totalSize);
         
+        releasedPages.assign((this->totalSize + pageSize - 1) / pageSize, PAGE_RESIDENT);
+        
         // Añadir el bloque completo como disponible
         freeBlocks[0].push_back(memoryPool);
     }
     
     BuddySystem::~BuddySystem() 
     {
+        stopTrimPolicy();
+        
         // Verificar fugas de memoria
-        if (!allocatedBlocks.empty()) {
-            std::cout << "[BUDDY] ADVERTENCIA: " << allocatedBlocks.size() 
+        if (allocatedCount > 0) {
+            std::cout << "[BUDDY] ADVERTENCIA: " << allocatedCount 
                       << " bloques no fueron liberados" << std::endl;
         }
         
         // Liberar el pool de memoria
-        delete[] memoryPool;
+        munmap(memoryPool, totalSize);
     }
     
     int BuddySystem::getLevel(size_t size) const 
@@ -142,8 +164,13 @@ namespace MemoryManagement
             return; // El buddy no está libre, no podemos fusionar
         }
         
-        // Eliminar el buddy de la lista de bloques libres
+        // Eliminar el buddy y el propio bloque de la lista de bloques libres;
+        // a partir de aquí sólo existe el bloque fusionado del nivel superior
         freeBlocks[level].erase(buddyIt);
+        auto blockIt = std::find(freeBlocks[level].begin(), freeBlocks[level].end(), block);
+        if (blockIt != freeBlocks[level].end()) {
+            freeBlocks[level].erase(blockIt);
+        }
         
         // Calcular el bloque fusionado (siempre es el que tiene la dirección menor)
         unsigned char* mergedBlock = (block < buddy) ? block : buddy;
@@ -157,7 +184,7 @@ namespace MemoryManagement
         }
     }
     
-    unsigned char* BuddySystem::allocate(size_t size) 
+    unsigned char* BuddySystem::allocateBlock(size_t size) 
     {
         // Ajustar el tamaño para que sea al menos el mínimo
         size = std::max(size, minBlockSize);
@@ -168,18 +195,29 @@ namespace MemoryManagement
             roundedSize <<= 1;
         }
         
+        if (roundedSize > totalSize) {
+            return nullptr;
+        }
+        
         // Buscar un bloque adecuado
         unsigned char* block = findBlock(roundedSize);
         if (!block) {
-            std::cerr << "[BUDDY] Error: No hay suficiente memoria para asignar " 
-                      << size << " bytes" << std::endl;
             return nullptr;
         }
         
         // Registrar el bloque asignado
         int level = getLevel(roundedSize);
         size_t actualSize = getSizeFromLevel(level);
-        allocatedBlocks[block] = actualSize;
+        blockLevels[(block - memoryPool) / getSizeFromLevel(levels - 1)] = static_cast<signed char>(level);
+        allocatedCount++;
+        
+        usedBytes += actualSize;
+        peakUsedBytes = std::max(peakUsedBytes, usedBytes);
+        lastActivity = std::chrono::steady_clock::now();
+        
+        if (releasedBytes > 0 || lazyFreedBytes > 0) {
+            markResident(block, actualSize);
+        }
         
         // Tocar la memoria para mejorar rendimiento de caché
         memset(block, 0, 64); // Tocar la primera línea de caché
@@ -187,27 +225,234 @@ namespace MemoryManagement
         return block;
     }
     
-    void BuddySystem::deallocate(unsigned char* ptr) 
+    bool BuddySystem::releaseBlock(unsigned char* ptr) 
     {
         // Verificar si el puntero es válido
-        auto it = allocatedBlocks.find(ptr);
-        if (it == allocatedBlocks.end()) {
-            std::cerr << "[BUDDY] Error: Intento de liberar un puntero no asignado" << std::endl;
-            return;
+        int level = allocatedLevel(ptr);
+        if (level < 0) {
+            return false;
         }
+        size_t size = getSizeFromLevel(level);
         
-        // Obtener el tamaño y calcular el nivel
-        size_t size = it->second;
-        int level = getLevel(size);
-        
-        // Eliminar del mapa de bloques asignados
-        allocatedBlocks.erase(it);
+        // Eliminar de la tabla de bloques asignados
+        blockLevels[(ptr - memoryPool) / getSizeFromLevel(levels - 1)] = -1;
+        allocatedCount--;
+        usedBytes -= size;
+        lastActivity = std::chrono::steady_clock::now();
         
         // Añadir a los bloques libres
         freeBlocks[level].push_back(ptr);
         
         // Intentar fusionar con su buddy
         mergeBlocks(ptr, level);
+        return true;
+    }
+    
+    unsigned char* BuddySystem::allocate(size_t size) 
+    {
+        unsigned char* block = tryAllocate(size);
+        if (!block) {
+            std::cerr << "[BUDDY] Error: No hay suficiente memoria para asignar " 
+                      << size << " bytes" << std::endl;
+        }
+        return block;
+    }
+    
+    unsigned char* BuddySystem::tryAllocate(size_t size) 
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        return allocateBlock(size);
+    }
+    
+    unsigned char* BuddySystem::reallocate(unsigned char* ptr, size_t newSize) 
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        
+        if (!ptr) {
+            return allocateBlock(newSize);
+        }
+        
+        int level = allocatedLevel(ptr);
+        if (level < 0) {
+            std::cerr << "[BUDDY] Error: Intento de redimensionar un puntero no asignado" << std::endl;
+            return nullptr;
+        }
+        
+        // Si el bloque actual ya tiene capacidad suficiente no hay nada que mover
+        size_t oldSize = getSizeFromLevel(level);
+        if (newSize <= oldSize) {
+            return ptr;
+        }
+        
+        unsigned char* block = allocateBlock(newSize);
+        if (!block) {
+            return nullptr;
+        }
+        
+        memcpy(block, ptr, oldSize);
+        releaseBlock(ptr);
+        
+        return block;
+    }
+    
+    void BuddySystem::deallocate(unsigned char* ptr) 
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!releaseBlock(ptr)) {
+            std::cerr << "[BUDDY] Error: Intento de liberar un puntero no asignado" << std::endl;
+        }
+    }
+    
+    bool BuddySystem::owns(const void* ptr) const 
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(ptr);
+        return p >= memoryPool && p < memoryPool + totalSize;
+    }
+    
+    size_t BuddySystem::blockSize(unsigned char* ptr) const 
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        int level = allocatedLevel(ptr);
+        return (level >= 0) ? getSizeFromLevel(level) : 0;
+    }
+    
+    int BuddySystem::allocatedLevel(const unsigned char* ptr) const 
+    {
+        size_t granule = getSizeFromLevel(levels - 1);
+        if (!owns(ptr) || (ptr - memoryPool) % granule != 0) {
+            return -1;
+        }
+        return blockLevels[(ptr - memoryPool) / granule];
+    }
+    
+    void BuddySystem::markResident(unsigned char* block, size_t size) 
+    {
+        size_t firstPage = (block - memoryPool) / pageSize;
+        size_t lastPage = (block - memoryPool + size - 1) / pageSize;
+        
+        for (size_t page = firstPage; page <= lastPage; page++) {
+            if (releasedPages[page] == PAGE_RELEASED) {
+                releasedBytes -= pageSize;
+            } else if (releasedPages[page] == PAGE_LAZY_FREED) {
+                lazyFreedBytes -= pageSize;
+            }
+            releasedPages[page] = PAGE_RESIDENT;
+        }
+    }
+    
+    size_t BuddySystem::trim(size_t hotReserve, bool lazyFree) 
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        return trimUnlocked(hotReserve, lazyFree);
+    }
+    
+    size_t BuddySystem::trimUnlocked(size_t hotReserve, bool lazyFree) 
+    {
+        // Sin MADV_FREE el recorte perezoso libera las páginas como el normal
+        int advice = MADV_DONTNEED;
+        unsigned char state = PAGE_RELEASED;
+        #if defined(MADV_FREE)
+        if (lazyFree) {
+            advice = MADV_FREE;
+            state = PAGE_LAZY_FREED;
+        }
+        #endif
+        
+        size_t keptBytes = 0;
+        size_t trimmedBytes = 0;
+        
+        // Los bloques pequeños forman la reserva caliente; se liberan los grandes.
+        // Del bloque que completa la reserva sólo se guardan las páginas que le
+        // faltan y se libera el resto, para no conservar un bloque entero (con el
+        // pool libre y fusionado, el único bloque es todo el pool)
+        for (int level = levels - 1; level >= 0; level--) {
+            size_t size = getSizeFromLevel(level);
+            
+            for (unsigned char* block : freeBlocks[level]) {
+                if (size < pageSize) {
+                    keptBytes += size;
+                    continue;
+                }
+                
+                size_t keep = 0;
+                if (keptBytes < hotReserve) {
+                    keep = std::min(size, (hotReserve - keptBytes + pageSize - 1) / pageSize * pageSize);
+                    keptBytes += keep;
+                }
+                if (keep == size) {
+                    continue;
+                }
+                
+                // Los bloques de al menos una página ya están alineados a página
+                unsigned char* tail = block + keep;
+                size_t firstPage = (tail - memoryPool) / pageSize;
+                size_t pageCount = (size - keep) / pageSize;
+                
+                // Páginas que cambian de estado: las residentes y, con
+                // MADV_DONTNEED, también las marcadas antes con MADV_FREE
+                auto changes = [&](size_t page) {
+                    return releasedPages[page] == PAGE_RESIDENT ||
+                           (releasedPages[page] == PAGE_LAZY_FREED && state == PAGE_RELEASED);
+                };
+                size_t changedPages = 0;
+                for (size_t page = firstPage; page < firstPage + pageCount; page++) {
+                    changedPages += changes(page) ? 1 : 0;
+                }
+                
+                if (changedPages == 0 || madvise(tail, size - keep, advice) != 0) {
+                    continue;
+                }
+                
+                for (size_t page = firstPage; page < firstPage + pageCount; page++) {
+                    if (!changes(page)) {
+                        continue;
+                    }
+                    if (releasedPages[page] == PAGE_LAZY_FREED) {
+                        lazyFreedBytes -= pageSize;
+                    }
+                    if (state == PAGE_RELEASED) {
+                        releasedBytes += pageSize;
+                    } else {
+                        lazyFreedBytes += pageSize;
+                    }
+                    releasedPages[page] = state;
+                }
+                trimmedBytes += changedPages * pageSize;
+            }
+        }
+        
+        return trimmedBytes;
+    }
+    
+    void BuddySystem::startTrimPolicy(std::chrono::milliseconds idleInterval, size_t hotReserve) 
+    {
+        stopTrimPolicy();
+        
+        trimStop = false;
+        trimThread = std::thread([this, idleInterval, hotReserve]() {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            while (!trimStop) {
+                trimCondition.wait_for(lock, idleInterval);
+                if (trimStop) break;
+                
+                // Sólo recortar si el pool ha estado inactivo todo el intervalo
+                if (std::chrono::steady_clock::now() - lastActivity >= idleInterval) {
+                    trimUnlocked(hotReserve, false);
+                }
+            }
+        });
+    }
+    
+    void BuddySystem::stopTrimPolicy() 
+    {
+        if (!trimThread.joinable()) return;
+        
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            trimStop = true;
+        }
+        trimCondition.notify_all();
+        trimThread.join();
     }
     
     // Método para procesar bloques 2D de manera eficiente
@@ -234,16 +479,16 @@ namespace MemoryManagement
     
     BuddySystem::MemoryStats BuddySystem::getStats() const 
     {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        
         MemoryStats stats;
         stats.totalMemory = totalSize;
-        
-        // Calcular memoria usada
-        stats.usedMemory = 0;
-        for (const auto& pair : allocatedBlocks) {
-            stats.usedMemory += pair.second;
-        }
-        
+        stats.usedMemory = usedBytes;
+        stats.peakMemory = peakUsedBytes;
         stats.freeMemory = totalSize - stats.usedMemory;
+        stats.reservedMemory = totalSize;
+        stats.residentMemory = totalSize - releasedBytes;
+        stats.lazyFreeMemory = lazyFreedBytes;
         
         // Calcular fragmentación: 1 - (mayor bloque libre / memoria libre total)
         size_t largestFreeBlock = 0;
@@ -3,9 +3,12 @@
 
 #include <cstddef>
 #include <vector>
-#include <unordered_map>
 #include <cmath>
 #include <functional>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
 
 namespace MemoryManagement 
 {
@@ -24,8 +27,34 @@ namespace MemoryManagement
         // Lista de bloques libres por nivel (potencia de 2)
         std::vector<std::vector<unsigned char*>> freeBlocks;
         
-        // Mapa para rastrear tamaños de bloques asignados
-        std::unordered_map<unsigned char*, size_t> allocatedBlocks;
+        // Nivel de cada bloque asignado, indexado por su offset en unidades del
+        // bloque más pequeño (-1 si no hay bloque asignado en esa posición).
+        // Tabla fija para que asignar y liberar no reserve memoria del heap.
+        std::vector<signed char> blockLevels;
+        size_t allocatedCount;
+        
+        // Bytes actualmente asignados y máximo alcanzado
+        size_t usedBytes;
+        size_t peakUsedBytes;
+        
+        // Protege las estructuras internas cuando el pool se comparte entre hilos
+        mutable std::mutex poolMutex;
+        
+        // Estado de cada página del pool (PAGE_RESIDENT, PAGE_RELEASED o
+        // PAGE_LAZY_FREED) y bytes de las liberadas con MADV_DONTNEED y con
+        // MADV_FREE. Las de MADV_FREE siguen residentes hasta que el kernel las
+        // reclame, así que no se descuentan de la memoria residente.
+        enum PageState : unsigned char { PAGE_RESIDENT = 0, PAGE_RELEASED = 1, PAGE_LAZY_FREED = 2 };
+        size_t pageSize;
+        std::vector<unsigned char> releasedPages;
+        size_t releasedBytes;
+        size_t lazyFreedBytes;
+        
+        // Política de recorte en segundo plano
+        std::thread trimThread;
+        std::condition_variable trimCondition;
+        bool trimStop;
+        std::chrono::steady_clock::time_point lastActivity;
         
         // Número de niveles en el sistema (basado en min y total size)
         int levels;
@@ -51,6 +80,19 @@ namespace MemoryManagement
         // Verificar si una dirección es un inicio válido de bloque para el nivel dado
         bool isValidBlockAddress(unsigned char* block, int level) const;
         
+        // Nivel del bloque asignado en ptr, o -1 si no es un bloque asignado
+        int allocatedLevel(const unsigned char* ptr) const;
+        
+        // Asignar y liberar sin tomar el mutex (el llamador ya lo tiene)
+        unsigned char* allocateBlock(size_t size);
+        bool releaseBlock(unsigned char* ptr);
+        
+        // Marcar como residentes las páginas de un bloque que se va a usar
+        void markResident(unsigned char* block, size_t size);
+        
+        // Recortar sin tomar el mutex
+        size_t trimUnlocked(size_t hotReserve, bool lazyFree);
+        
     public:
         // Constructor
         BuddySystem(size_t totalSize, size_t minBlockSize = 64);
@@ -61,9 +103,33 @@ namespace MemoryManagement
         // Asignar memoria
         unsigned char* allocate(size_t size);
         
+        // Igual que allocate, pero sin reportar error si el pool está lleno
+        unsigned char* tryAllocate(size_t size);
+        
+        // Redimensionar un bloque (semántica de realloc); devuelve nullptr si no
+        // hay espacio en el pool, dejando el bloque original intacto
+        unsigned char* reallocate(unsigned char* ptr, size_t newSize);
+        
         // Liberar memoria
         void deallocate(unsigned char* ptr);
         
+        // Indica si el puntero pertenece a este pool
+        bool owns(const void* ptr) const;
+        
+        // Tamaño real del bloque asignado en ptr (0 si no está asignado)
+        size_t blockSize(unsigned char* ptr) const;
+        
+        // Devolver al sistema operativo las páginas de los bloques libres grandes,
+        // conservando al menos hotReserve bytes libres residentes. Con lazyFree se
+        // usa MADV_FREE (el kernel las recupera sólo bajo presión de memoria): esas
+        // páginas siguen contando como residentes y se informan aparte en
+        // MemoryStats::lazyFreeMemory. Devuelve los bytes liberados o marcados.
+        size_t trim(size_t hotReserve = 0, bool lazyFree = false);
+        
+        // Recortar automáticamente cuando el pool lleve idleInterval sin actividad
+        void startTrimPolicy(std::chrono::milliseconds idleInterval, size_t hotReserve = 0);
+        void stopTrimPolicy();
+        
         // Método para procesar bloques 2D de manera eficiente
         void process2DBlock(unsigned char* buffer, int width, int height, int channels,
                            std::function<void(unsigned char*, int, int, int)> processor);
@@ -73,6 +139,11 @@ namespace MemoryManagement
             size_t totalMemory;
             size_t usedMemory;
             size_t freeMemory;
+            size_t peakMemory;
+            size_t reservedMemory;  // Espacio de direcciones del pool
+            size_t residentMemory;  // Parte del pool no devuelta al sistema
+            size_t lazyFreeMemory;  // Parte residente marcada con MADV_FREE (el kernel
+                                    // puede reclamarla hasta que se vuelva a usar)
             float fragmentation;
         };
         
@@ -2,6 +2,98 @@
 #include <iostream>
 #include <stdexcept>
 #include <cstring>  // Para memcpy
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+
+namespace
+{
+    // Pool compartido por los códecs de stb y los buffers intermedios de E/S.
+    // Se conserva entre imágenes para que la memoria ya esté tocada (caliente)
+    // y sólo se reemplaza por uno mayor cuando está vacío.
+    std::mutex codecPoolMutex;
+    MemoryManagement::BuddySystem* codecPool = nullptr;
+
+    // Política de recorte configurada; se reaplica si el pool se reemplaza
+    std::chrono::milliseconds codecTrimInterval(0);
+    size_t codecTrimReserve = 0;
+
+    // Las peticiones que no caben en el pool se sirven con malloc
+    void* codecMalloc(size_t size)
+    {
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        void* ptr = codecPool ? codecPool->tryAllocate(size) : nullptr;
+        return ptr ? ptr : malloc(size);
+    }
+
+    void codecFree(void* ptr)
+    {
+        if (!ptr) return;
+
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        if (codecPool && codecPool->owns(ptr)) {
+            codecPool->deallocate(static_cast<unsigned char*>(ptr));
+        } else {
+            free(ptr);
+        }
+    }
+
+    void* codecRealloc(void* ptr, size_t newSize)
+    {
+        if (!ptr) return codecMalloc(newSize);
+
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        if (!codecPool || !codecPool->owns(ptr)) {
+            return realloc(ptr, newSize);
+        }
+
+        unsigned char* block = static_cast<unsigned char*>(ptr);
+        unsigned char* grown = codecPool->reallocate(block, newSize);
+        if (grown) return grown;
+
+        // El pool no tiene espacio: mover el bloque al heap
+        void* heapBlock = malloc(newSize);
+        if (!heapBlock) return nullptr;
+        memcpy(heapBlock, block, std::min(codecPool->blockSize(block), newSize));
+        codecPool->deallocate(block);
+        return heapBlock;
+    }
+
+    // Garantiza un pool de al menos 'bytes'. Sólo se reemplaza si no tiene
+    // bloques vivos, para no invalidar punteros entregados a stb.
+    void ensureCodecPool(size_t bytes)
+    {
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        if (codecPool) {
+            MemoryManagement::BuddySystem::MemoryStats stats = codecPool->getStats();
+            if (stats.totalMemory >= bytes || stats.usedMemory > 0) {
+                return;
+            }
+            delete codecPool;
+        }
+        codecPool = new MemoryManagement::BuddySystem(bytes);
+        if (codecTrimInterval.count() > 0) {
+            codecPool->startTrimPolicy(codecTrimInterval, codecTrimReserve);
+        }
+    }
+
+    // Estimación de memoria de trabajo de stb: salida, buffers por componente
+    // del decodificador/codificador y margen para tablas y cabeceras
+    size_t codecWorkingSet(int width, int height, int channels)
+    {
+        return (size_t)width * height * channels * 3 + (1 << 20);
+    }
+}
+
+// Redirigir las asignaciones internas de stb al pool de códecs
+#define STBI_MALLOC(sz)        codecMalloc(sz)
+#define STBI_REALLOC(p, newsz) codecRealloc(p, newsz)
+#define STBI_FREE(p)           codecFree(p)
+#define STBIW_MALLOC(sz)        codecMalloc(sz)
+#define STBIW_REALLOC(p, newsz) codecRealloc(p, newsz)
+#define STBIW_FREE(p)           codecFree(p)
 
 // Necesitarás incluir alguna biblioteca para manipulación de imágenes
 // Por ejemplo: stb_image.h (una biblioteca de cabecera única)
@@ -15,14 +107,47 @@
 #include <omp.h>
 #endif
 
-namespace FileIO
+namespace
 {
-    bool loadImage(const std::string &filename, ImageProcessor::Image &image, bool useBuddySystem)
+    // Gamma con la que stbi_loadf convierte las imágenes LDR a float lineal (el
+    // canal alfa no se corrige); al guardar en 8 o 16 bits se deshace
+    const float LDR_GAMMA = 2.2f;
+
+    std::string fileExtension(const std::string &filename)
+    {
+        return filename.substr(filename.find_last_of(".") + 1);
+    }
+
+    // Decodificador de stb para cada tipo de muestra (el puntero sólo elige la sobrecarga)
+    uint8_t *decodeSamples(const std::string &filename, int *width, int *height, int *channels, uint8_t *)
+    {
+        return stbi_load(filename.c_str(), width, height, channels, 0);
+    }
+
+    uint16_t *decodeSamples(const std::string &filename, int *width, int *height, int *channels, uint16_t *)
+    {
+        return stbi_load_16(filename.c_str(), width, height, channels, 0);
+    }
+
+    float *decodeSamples(const std::string &filename, int *width, int *height, int *channels, float *)
+    {
+        return stbi_loadf(filename.c_str(), width, height, channels, 0);
+    }
+
+    template <typename T>
+    bool loadSamples(const std::string &filename, ImageProcessor::ImageT<T> &image, bool useBuddySystem,
+                     ImageProcessor::PixelLayout layout)
     {
         int width, height, channels;
 
+        // Preparar el pool de códecs con el tamaño de la imagen antes de decodificar
+        if (stbi_info(filename.c_str(), &width, &height, &channels))
+        {
+            ensureCodecPool(codecWorkingSet(width, height, channels * sizeof(T)));
+        }
+
         // Carga la imagen usando stb_image
-        unsigned char *data = stbi_load(filename.c_str(), &width, &height, &channels, 0);
+        T *data = decodeSamples(filename, &width, &height, &channels, static_cast<T *>(nullptr));
 
         if (!data)
         {
@@ -31,31 +156,33 @@ namespace FileIO
             return false;
         }
 
+        // Sin Buddy System y en disposición intercalada, la imagen adopta el buffer
+        // decodificado tal cual (sin copia), con el stride del decodificador (filas sin
+        // relleno, que en general no empiezan alineadas); se libera con codecFree al
+        // soltarlo. Ningún kernel necesita filas alineadas
+        if (layout == ImageProcessor::PixelLayout::Interleaved && !useBuddySystem)
+        {
+            image.adoptBuffer(data, width, height, channels, (size_t)width * channels, codecFree);
+            return true;
+        }
+
         // Reserva memoria para la imagen en nuestro formato
         image.width = width;
         image.height = height;
         image.channels = channels;
-        image.allocateMemory(useBuddySystem); // Pasar el modo de asignación
+        image.layout = layout;
+        image.ensureMemory(useBuddySystem); // Pasar el modo de asignación
 
         // Configurar número de hilos para OpenMP
         #if defined(_OPENMP)
         omp_set_num_threads(4);
         #endif
 
-        // Copia los datos al formato de nuestra matriz tridimensional con paralelización
-        #if defined(_OPENMP)
-        #pragma omp parallel for collapse(2) schedule(dynamic, 16)
-        #endif
-        for (int y = 0; y < height; y++)
-        {
-            for (int x = 0; x < width; x++)
-            {
-                for (int c = 0; c < channels; c++)
-                {
-                    image.pixels[y][x][c] = data[(y * width + x) * channels + c];
-                }
-            }
-        }
+        // Copia los datos al buffer de la imagen (que puede tener relleno por fila),
+        // separando los canales en planos o repartiendo los píxeles en teselas si se
+        // pidió esa disposición
+        ImageProcessor::ImageViewT<T> decoded(data, width, height, channels, (size_t)width * channels);
+        ImageProcessor::convertLayout(decoded, image.view());
 
         // Libera la memoria utilizada por stb_image
         stbi_image_free(data);
@@ -63,52 +190,93 @@ namespace FileIO
         return true;
     }
 
-    bool saveImage(const std::string &filename, const ImageProcessor::Image &image)
+    // Copia la vista a un buffer intercalado y sin relleno (el formato que esperan
+    // los codificadores). Se libera con codecFree.
+    template <typename T>
+    T *stageSamples(const ImageProcessor::ImageViewT<T> &image)
     {
-        // Convertir nuestra estructura de imagen al formato lineal esperado por stb_image_write
-        unsigned char *data = new unsigned char[image.width * image.height * image.channels];
+        ensureCodecPool(codecWorkingSet(image.width, image.height, image.channels * sizeof(T)));
+        size_t rowSamples = (size_t)image.width * image.channels;
+        T *data = static_cast<T *>(codecMalloc(rowSamples * image.height * sizeof(T)));
 
         // Configurar número de hilos para OpenMP
         #if defined(_OPENMP)
         omp_set_num_threads(4);
         #endif
 
-        // Conversión paralela de la estructura de matriz 3D a buffer lineal
-        #if defined(_OPENMP)
-        #pragma omp parallel for collapse(2) schedule(dynamic, 16)
-        #endif
-        for (int y = 0; y < image.height; y++)
+        // Intercalar los canales si la imagen está en disposición planar o en teselas
+        ImageProcessor::ImageViewT<T> staging(data, image.width, image.height, image.channels, rowSamples);
+        ImageProcessor::convertLayout(image, staging);
+        return data;
+    }
+
+    // Vista intercalada (sin planos ni teselas) con los píxeles de image: la propia
+    // vista si ya lo es, sin copia, o una copia en staging que queda en 'staged' para
+    // liberarla con codecFree. requireTight exige además filas sin relleno (para los
+    // codificadores que no aceptan stride).
+    template <typename T>
+    ImageProcessor::ImageViewT<T> encoderView(const ImageProcessor::ImageViewT<T> &image, bool requireTight,
+                                              T *&staged)
+    {
+        size_t rowSamples = (size_t)image.width * image.channels;
+        staged = nullptr;
+
+        if (!image.isPlanar() && !image.isTiled() && (!requireTight || image.stride == rowSamples))
         {
-            for (int x = 0; x < image.width; x++)
-            {
-                for (int c = 0; c < image.channels; c++)
-                {
-                    data[(y * image.width + x) * image.channels + c] = image.pixels[y][x][c];
-                }
+            return image;
+        }
+
+        staged = stageSamples(image);
+        return ImageProcessor::ImageViewT<T>(staged, image.width, image.height, image.channels, rowSamples);
+    }
+
+    // Convierte una vista intercalada (con o sin relleno por fila) a muestras de otro
+    // tipo sin relleno; convert recibe la muestra y si pertenece al canal alfa
+    // (último canal con 2 o 4 canales)
+    template <typename Out, typename T, typename Convert>
+    Out *convertSamples(const ImageProcessor::ImageViewT<T> &image, Convert convert)
+    {
+        const int channels = image.channels;
+        size_t rowSamples = (size_t)image.width * channels;
+        Out *out = static_cast<Out *>(codecMalloc(rowSamples * image.height * sizeof(Out)));
+        bool hasAlpha = (channels % 2) == 0;
+
+        for (int y = 0; y < image.height; y++) {
+            const T *in = image.row(y);
+            Out *outRow = out + y * rowSamples;
+            for (size_t i = 0; i < rowSamples; i++) {
+                outRow[i] = convert(in[i], hasAlpha && (int)(i % channels) == channels - 1);
             }
         }
+        return out;
+    }
+
+    // Extensiones cuyo codificador acepta filas con relleno (stride); el resto
+    // necesita las muestras contiguas
+    bool encoderAcceptsStride(const std::string &filename)
+    {
+        return fileExtension(filename) == "png";
+    }
 
-        // Determinar el formato de salida basado en la extensión del archivo
+    // Escribe una vista de 8 bits intercalada según la extensión (en JPG, sin relleno)
+    bool writeSamples8(const std::string &filename, const ImageProcessor::ImageView &image)
+    {
         bool success = false;
-        std::string ext = filename.substr(filename.find_last_of(".") + 1);
+        std::string ext = fileExtension(filename);
+        const int width = image.width, height = image.height, channels = image.channels;
 
         if (ext == "jpg" || ext == "jpeg")
         {
-            success = stbi_write_jpg(filename.c_str(), image.width, image.height, image.channels, data, 90);
+            success = stbi_write_jpg(filename.c_str(), width, height, channels, image.data, 90);
         }
         else if (ext == "png")
         {
             // Para imágenes PNG, ajustar la compresión para equilibrar velocidad y tamaño
             int prevLevel = stbi_write_png_compression_level;
             stbi_write_png_compression_level = 3; // Menor compresión, más rápido
-            
-            success = stbi_write_png(filename.c_str(), 
-                                    image.width, 
-                                    image.height, 
-                                    image.channels, 
-                                    data, 
-                                    image.width * image.channels);
-            
+
+            success = stbi_write_png(filename.c_str(), width, height, channels, image.data, (int)image.stride);
+
             // Restaurar el nivel de compresión predeterminado
             stbi_write_png_compression_level = prevLevel;
         }
@@ -117,7 +285,236 @@ namespace FileIO
             std::cerr << "Formato de archivo no soportado: " << ext << std::endl;
         }
 
-        delete[] data;
+        return success;
+    }
+
+    // CRC-32 de los fragmentos PNG (polinomio 0xEDB88320), acumulable por partes
+    struct CrcTable
+    {
+        unsigned int values[256];
+
+        CrcTable()
+        {
+            for (unsigned int n = 0; n < 256; n++) {
+                unsigned int c = n;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                }
+                values[n] = c;
+            }
+        }
+    };
+
+    unsigned int crc32Update(unsigned int crc, const unsigned char *data, size_t length)
+    {
+        static const CrcTable table;
+
+        crc = ~crc;
+        for (size_t i = 0; i < length; i++) {
+            crc = table.values[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void putBigEndian32(unsigned char *out, unsigned int value)
+    {
+        out[0] = (unsigned char)(value >> 24);
+        out[1] = (unsigned char)(value >> 16);
+        out[2] = (unsigned char)(value >> 8);
+        out[3] = (unsigned char)value;
+    }
+
+    bool writePngChunk(FILE *f, const char *type, const unsigned char *data, unsigned int length)
+    {
+        unsigned char header[8], footer[4];
+        putBigEndian32(header, length);
+        memcpy(header + 4, type, 4);
+
+        unsigned int crc = crc32Update(0, header + 4, 4);
+        crc = crc32Update(crc, data, length);
+        putBigEndian32(footer, crc);
+
+        return fwrite(header, 1, 8, f) == 8 && (length == 0 || fwrite(data, 1, length, f) == length) &&
+               fwrite(footer, 1, 4, f) == 4;
+    }
+
+    // PNG de 16 bits por muestra (stb_image_write sólo escribe PNG de 8 bits) a partir
+    // de una vista intercalada. Las filas usan el filtro Sub y se comprimen con el
+    // zlib de stb_image_write.
+    bool writePng16(const std::string &filename, const ImageProcessor::ImageView16 &image)
+    {
+        const int width = image.width, height = image.height, channels = image.channels;
+        static const unsigned char colorTypes[] = {0, 0, 4, 2, 6}; // gris, gris+alfa, RGB, RGBA
+        if (channels < 1 || channels > 4) {
+            std::cerr << "PNG de 16 bits no soportado con " << channels << " canales" << std::endl;
+            return false;
+        }
+
+        const int pixelBytes = channels * 2;
+        const size_t rowBytes = (size_t)width * pixelBytes;
+        const size_t filteredSize = (rowBytes + 1) * height;
+        unsigned char *filtered = static_cast<unsigned char *>(codecMalloc(filteredSize));
+
+        for (int y = 0; y < height; y++) {
+            unsigned char *out = filtered + y * (rowBytes + 1);
+            const uint16_t *in = image.row(y);
+            out[0] = 1; // Filtro Sub
+            out++;
+
+            // Las muestras de 16 bits se guardan en big-endian
+            for (size_t i = 0; i < (size_t)width * channels; i++) {
+                out[2 * i]     = (unsigned char)(in[i] >> 8);
+                out[2 * i + 1] = (unsigned char)(in[i] & 0xff);
+            }
+
+            // Restar el byte correspondiente del píxel anterior (de atrás hacia delante
+            // para usar los valores sin filtrar)
+            for (size_t i = rowBytes; i-- > (size_t)pixelBytes;) {
+                out[i] = (unsigned char)(out[i] - out[i - pixelBytes]);
+            }
+        }
+
+        int zlibSize = 0;
+        unsigned char *zlib = stbi_zlib_compress(filtered, (int)filteredSize, &zlibSize, 3);
+        codecFree(filtered);
+        if (!zlib) {
+            return false;
+        }
+
+        unsigned char ihdr[13];
+        putBigEndian32(ihdr, width);
+        putBigEndian32(ihdr + 4, height);
+        ihdr[8]  = 16;                   // Bits por muestra
+        ihdr[9]  = colorTypes[channels]; // Tipo de color
+        ihdr[10] = 0;                    // Compresión deflate
+        ihdr[11] = 0;                    // Filtrado adaptativo estándar
+        ihdr[12] = 0;                    // Sin entrelazado
+
+        static const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+        bool success = false;
+        FILE *f = fopen(filename.c_str(), "wb");
+        if (f) {
+            success = fwrite(signature, 1, 8, f) == 8 &&
+                      writePngChunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+                      writePngChunk(f, "IDAT", zlib, zlibSize) &&
+                      writePngChunk(f, "IEND", nullptr, 0);
+            success = (fclose(f) == 0) && success;
+        }
+
+        codecFree(zlib);
+        return success;
+    }
+
+    // Deshace la gamma de stbi_loadf y lleva [0, 1] al rango del entero de salida
+    float encodeLinear(float value, bool alpha, float maxValue)
+    {
+        value = std::max(0.0f, std::min(1.0f, value));
+        if (!alpha) {
+            value = std::pow(value, 1.0f / LDR_GAMMA);
+        }
+        return value * maxValue + 0.5f;
+    }
+}
+
+namespace FileIO
+{
+    bool loadImage(const std::string &filename, ImageProcessor::Image &image, bool useBuddySystem,
+                   ImageProcessor::PixelLayout layout)
+    {
+        return loadSamples(filename, image, useBuddySystem, layout);
+    }
+
+    bool loadImage(const std::string &filename, ImageProcessor::Image16 &image, bool useBuddySystem,
+                   ImageProcessor::PixelLayout layout)
+    {
+        return loadSamples(filename, image, useBuddySystem, layout);
+    }
+
+    bool loadImage(const std::string &filename, ImageProcessor::ImageF &image, bool useBuddySystem,
+                   ImageProcessor::PixelLayout layout)
+    {
+        return loadSamples(filename, image, useBuddySystem, layout);
+    }
+
+    bool saveImage(const std::string &filename, const ImageProcessor::Image &image)
+    {
+        return saveImage(filename, image.view());
+    }
+
+    bool saveImage(const std::string &filename, const ImageProcessor::Image16 &image)
+    {
+        return saveImage(filename, image.view());
+    }
+
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageF &image)
+    {
+        return saveImage(filename, image.view());
+    }
+
+    // Las vistas intercaladas se entregan directamente al codificador; sólo se copian
+    // las planares o en teselas, y las que tienen relleno si el formato no admite stride
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageView &image)
+    {
+        uint8_t *staged;
+        ImageProcessor::ImageView samples = encoderView(image, !encoderAcceptsStride(filename), staged);
+        bool success = writeSamples8(filename, samples);
+        codecFree(staged);
+        return success;
+    }
+
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageView16 &image)
+    {
+        uint16_t *staged;
+        ImageProcessor::ImageView16 samples = encoderView(image, false, staged);
+        bool success = false;
+
+        if (fileExtension(filename) == "png")
+        {
+            success = writePng16(filename, samples);
+        }
+        else
+        {
+            // Los formatos de 8 bits se quedan con el byte alto de cada muestra
+            uint8_t *data8 = convertSamples<uint8_t>(samples, [](uint16_t v, bool) { return (uint8_t)(v >> 8); });
+            success = writeSamples8(filename, ImageProcessor::ImageView(data8, image.width, image.height,
+                                                                        image.channels, (size_t)image.width * image.channels));
+            codecFree(data8);
+        }
+
+        codecFree(staged);
+        return success;
+    }
+
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageViewF &image)
+    {
+        std::string ext = fileExtension(filename);
+        float *staged;
+        ImageProcessor::ImageViewF samples = encoderView(image, ext == "hdr", staged);
+        const size_t rowSamples = (size_t)image.width * image.channels;
+        bool success = false;
+
+        if (ext == "hdr")
+        {
+            success = stbi_write_hdr(filename.c_str(), image.width, image.height, image.channels, samples.data);
+        }
+        else if (ext == "png")
+        {
+            uint16_t *data16 = convertSamples<uint16_t>(samples,
+                [](float v, bool alpha) { return (uint16_t)encodeLinear(v, alpha, 65535.0f); });
+            success = writePng16(filename, ImageProcessor::ImageView16(data16, image.width, image.height,
+                                                                       image.channels, rowSamples));
+            codecFree(data16);
+        }
+        else
+        {
+            uint8_t *data8 = convertSamples<uint8_t>(samples,
+                [](float v, bool alpha) { return (uint8_t)encodeLinear(v, alpha, 255.0f); });
+            success = writeSamples8(filename, ImageProcessor::ImageView(data8, image.width, image.height,
+                                                                        image.channels, rowSamples));
+            codecFree(data8);
+        }
+
+        codecFree(staged);
         return success;
     }
 
@@ -151,6 +548,12 @@ namespace FileIO
             return true;
         }
 
+        // Verificar formato Radiance HDR (datos en float)
+        if (header[0] == '#' && header[1] == '?')
+        {
+            return true;
+        }
+
         return false;
     }
 
@@ -160,6 +563,9 @@ namespace FileIO
     {
         // Abrir la imagen para obtener su información
         int width, height, channels;
+        if (stbi_info(inputFilename.c_str(), &width, &height, &channels)) {
+            ensureCodecPool(codecWorkingSet(width, height, channels));
+        }
         unsigned char *data = stbi_load(inputFilename.c_str(), &width, &height, &channels, 0);
         
         if (!data) {
@@ -176,7 +582,8 @@ namespace FileIO
         const int CHUNK_HEIGHT = 128; // Procesar 128 filas a la vez
         
         // Crear buffer para un chunk
-        unsigned char *chunk = new unsigned char[width * CHUNK_HEIGHT * channels];
+        unsigned char *chunk = static_cast<unsigned char *>(
+            codecMalloc((size_t)width * CHUNK_HEIGHT * channels));
         
         // Procesar la imagen en chunks
         for (int y = 0; y < height; y += CHUNK_HEIGHT) {
@@ -218,10 +625,40 @@ namespace FileIO
         }
         
         // Liberar memoria
-        delete[] chunk;
+        codecFree(chunk);
         stbi_image_free(data);
         
         return success;
     }
 
+    MemoryManagement::BuddySystem::MemoryStats getCodecPoolStats()
+    {
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        if (codecPool) {
+            return codecPool->getStats();
+        }
+
+        return MemoryManagement::BuddySystem::MemoryStats();
+    }
+
+    size_t trimCodecPool(size_t hotReserve)
+    {
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        return codecPool ? codecPool->trim(hotReserve) : 0;
+    }
+
+    void setCodecPoolTrimPolicy(std::chrono::milliseconds idleInterval, size_t hotReserve)
+    {
+        std::lock_guard<std::mutex> lock(codecPoolMutex);
+        codecTrimInterval = idleInterval;
+        codecTrimReserve = hotReserve;
+
+        if (!codecPool) return;
+        if (idleInterval.count() > 0) {
+            codecPool->startTrimPolicy(idleInterval, hotReserve);
+        } else {
+            codecPool->stopTrimPolicy();
+        }
+    }
+
 } // namespace FileIO
\ No newline at end of file
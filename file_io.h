@@ -4,15 +4,34 @@
 #include "image_processor.h"
 #include <string>
 #include <functional>
+#include <chrono>
 
 // Funciones para manipulación de archivos de imagen
 namespace FileIO
 {
-    // Carga una imagen desde un archivo y la convierte al formato interno
-    bool loadImage(const std::string &filename, ImageProcessor::Image &image, bool useBuddySystem = false);
+    // Carga una imagen desde un archivo y la convierte al formato interno. En
+    // disposición en teselas se usa el lado de tesela que ya tenga image.tileSize
+    // Image16 usa stbi_load_16 (las fuentes de 8 bits se amplían a 16) e ImageF usa
+    // stbi_loadf (muestras lineales; las fuentes LDR pasan a [0, 1] con gamma 2.2)
+    // En disposición intercalada y sin Buddy System la imagen adopta el buffer que
+    // devuelve el decodificador, sin copiarlo (las filas quedan sin relleno)
+    bool loadImage(const std::string &filename, ImageProcessor::Image &image, bool useBuddySystem = false,
+                   ImageProcessor::PixelLayout layout = ImageProcessor::PixelLayout::Interleaved);
+    bool loadImage(const std::string &filename, ImageProcessor::Image16 &image, bool useBuddySystem = false,
+                   ImageProcessor::PixelLayout layout = ImageProcessor::PixelLayout::Interleaved);
+    bool loadImage(const std::string &filename, ImageProcessor::ImageF &image, bool useBuddySystem = false,
+                   ImageProcessor::PixelLayout layout = ImageProcessor::PixelLayout::Interleaved);
 
-    // Guarda una imagen procesada a un archivo
+    // Guarda una imagen procesada a un archivo. Las imágenes de 16 bits se guardan
+    // como PNG de 16 bits; las float como .hdr, o como PNG de 16 bits / JPG de 8
+    // bits deshaciendo la gamma de carga. En JPG las muestras se reducen a 8 bits.
+    // Las imágenes intercaladas se pasan al codificador sin copia intermedia.
     bool saveImage(const std::string &filename, const ImageProcessor::Image &image);
+    bool saveImage(const std::string &filename, const ImageProcessor::Image16 &image);
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageF &image);
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageView &image);
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageView16 &image);
+    bool saveImage(const std::string &filename, const ImageProcessor::ImageViewF &image);
 
     // Verifica si un archivo es una imagen válida
     bool isValidImageFile(const std::string &filename);
@@ -20,6 +39,16 @@ namespace FileIO
     // Procesa una imagen grande en bloques con paralelización
     bool processBigImageInChunks(const std::string &inputFilename, const std::string &outputFilename, 
                              std::function<void(unsigned char*, int, int, int)> processor);
+
+    // Estadísticas del pool compartido que usan stb_image/stb_image_write
+    MemoryManagement::BuddySystem::MemoryStats getCodecPoolStats();
+
+    // Devuelve al sistema las páginas libres del pool de códecs, conservando
+    // hotReserve bytes calientes para la siguiente imagen
+    size_t trimCodecPool(size_t hotReserve = 0);
+
+    // Recorta el pool de códecs tras idleInterval sin actividad (0 desactiva)
+    void setCodecPoolTrimPolicy(std::chrono::milliseconds idleInterval, size_t hotReserve = 0);
 } // namespace FileIO
 
 #endif // FILE_IO_H
\ No newline at end of file
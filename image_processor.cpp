@@ -1,8 +1,17 @@
 #include "image_processor.h"
+#include "remap_simd.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <new>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // Verificar si OpenMP está disponible
 #if defined(_OPENMP)
@@ -12,32 +21,198 @@
 namespace ImageProcessor
 {
     // Inicialización de variables estáticas
-    bool Image::useParallelization = true;
-    int Image::numThreads = 4;
+    bool ImageBase::useParallelization = true;
+    bool ImageBase::useIntegerInterpolation = true;
+    BilinearSimd::Level ImageBase::simdLevel = BilinearSimd::detectLevel();
+    int ImageBase::numThreads = 4;
+    ResampleFilter ImageBase::resampleFilter = ResampleFilter::Bilinear;
+    RotationEngine ImageBase::rotationEngine = RotationEngine::Direct;
+    BorderMode ImageBase::borderMode = BorderMode::Constant;
+    float ImageBase::borderColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
 
-    Image::Image()
+    const char* filterName(ResampleFilter filter)
+    {
+        switch (filter) {
+            case ResampleFilter::Nearest:  return "vecino";
+            case ResampleFilter::Bicubic:  return "bicúbico";
+            case ResampleFilter::Lanczos3: return "Lanczos-3";
+            default:                       return "bilineal";
+        }
+    }
+
+    const char* engineName(RotationEngine engine)
+    {
+        return engine == RotationEngine::Shear ? "tres cizallas" : "directa";
+    }
+
+    const char* borderName(BorderMode mode)
+    {
+        switch (mode) {
+            case BorderMode::Clamp:   return "replicar";
+            case BorderMode::Reflect: return "reflejar";
+            case BorderMode::Wrap:    return "mosaico";
+            default:                  return "constante";
+        }
+    }
+
+    // Separa una fila intercalada en C planos; C fijo permite desenrollar el bucle
+    template <int C, typename T>
+    static void deinterleaveRow(const T *in, T *const *planes, int width, int channels)
+    {
+        const int n = (C > 0) ? C : channels;
+        for (int x = 0; x < width; x++) {
+            for (int c = 0; c < n; c++) {
+                planes[c][x] = in[x * n + c];
+            }
+        }
+    }
+
+    // Operación inversa: intercala C planos en una fila
+    template <int C, typename T>
+    static void interleaveRow(const T *const *planes, T *out, int width, int channels)
+    {
+        const int n = (C > 0) ? C : channels;
+        for (int x = 0; x < width; x++) {
+            for (int c = 0; c < n; c++) {
+                out[x * n + c] = planes[c][x];
+            }
+        }
+    }
+
+    // Píxeles que quedan desde x hasta el final de la tesela (o de la fila)
+    template <typename T>
+    static inline int runLength(const ImageViewT<T> &view, int x)
+    {
+        int remaining = view.width - x;
+        if (!view.isTiled()) {
+            return remaining;
+        }
+        return std::min(remaining, (1 << view.tileShift) - ((x + view.originX) & ((1 << view.tileShift) - 1)));
+    }
+
+    template <typename T>
+    void convertLayout(const ImageViewT<T> &src, const ImageViewT<T> &dst)
+    {
+        const int MAX_PLANES = 16;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for schedule(static) if(ImageBase::useParallelization)
+        #endif
+        for (int y = 0; y < src.height; y++) {
+            // Ambas planares: copia directa de la fila de cada plano
+            if (src.isPlanar() && dst.isPlanar()) {
+                for (int c = 0; c < src.channels; c++) {
+                    memcpy(dst.row(y) + c * dst.planeStride, src.row(y) + c * src.planeStride, src.width * sizeof(T));
+                }
+                continue;
+            }
+
+            // Recorrer la fila en tramos que no cruzan teselas: dentro de un tramo los
+            // píxeles intercalados son contiguos en origen y en destino. Sin teselas
+            // el tramo es la fila entera.
+            for (int x = 0, run = 0; x < src.width; x += run) {
+                run = std::min(runLength(src, x), runLength(dst, x));
+
+                if (!src.isPlanar() && !dst.isPlanar()) {
+                    memcpy(dst.pixelAt(x, y), src.pixelAt(x, y), (size_t)run * src.channels * sizeof(T));
+                    continue;
+                }
+
+                T *planeRows[MAX_PLANES];
+                const ImageViewT<T> &planar = src.isPlanar() ? src : dst;
+                for (int c = 0; c < planar.channels && c < MAX_PLANES; c++) {
+                    planeRows[c] = planar.row(y) + c * planar.planeStride + x;
+                }
+
+                if (dst.isPlanar()) {
+                    const T *in = src.pixelAt(x, y);
+                    switch (src.channels) {
+                        case 3:  deinterleaveRow<3>(in, planeRows, run, 3); break;
+                        case 4:  deinterleaveRow<4>(in, planeRows, run, 4); break;
+                        default: deinterleaveRow<0>(in, planeRows, run, src.channels); break;
+                    }
+                } else {
+                    T *out = dst.pixelAt(x, y);
+                    switch (src.channels) {
+                        case 3:  interleaveRow<3, T>(planeRows, out, run, 3); break;
+                        case 4:  interleaveRow<4, T>(planeRows, out, run, 4); break;
+                        default: interleaveRow<0, T>(planeRows, out, run, src.channels); break;
+                    }
+                }
+            }
+        }
+    }
+
+    // Rellena la tabla de posiciones de las teselas. En orden Z se recorren los
+    // códigos de Morton del cuadrado potencia de 2 que cubre la rejilla y se
+    // numeran consecutivamente las teselas que existen, sin dejar huecos.
+    static void fillTileOffsets(size_t *offsets, int columns, int rows, size_t tileSamples, bool morton)
+    {
+        if (!morton) {
+            for (size_t i = 0; i < (size_t)columns * rows; i++) {
+                offsets[i] = i * tileSamples;
+            }
+            return;
+        }
+
+        size_t side = 1;
+        while (side < (size_t)columns || side < (size_t)rows) {
+            side <<= 1;
+        }
+
+        size_t slot = 0;
+        for (size_t code = 0; code < side * side; code++) {
+            // Bits pares del código: columna; bits impares: fila
+            size_t tx = 0, ty = 0;
+            for (int bit = 0; (code >> (2 * bit)) != 0; bit++) {
+                tx |= ((code >> (2 * bit)) & 1) << bit;
+                ty |= ((code >> (2 * bit + 1)) & 1) << bit;
+            }
+
+            if (tx < (size_t)columns && ty < (size_t)rows) {
+                offsets[ty * columns + tx] = slot++ * tileSamples;
+            }
+        }
+    }
+
+    template <typename T>
+    ImageT<T>::ImageT()
         : width(0),
           height(0),
           channels(0),
-          pixels(nullptr),
+          data(nullptr),
+          allocationBase(nullptr),
+          layout(PixelLayout::Interleaved),
+          stride(0),
+          planeStride(0),
+          tileSize(DEFAULT_TILE_SIZE),
+          tileOffsets(nullptr),
           usingBuddySystem(false),
           buddySystem(nullptr),
-          buddyBuffer(nullptr),
-          totalBufferSize(0)
+          totalBufferSize(0),
+          references(nullptr),
+          externalBuffer(false),
+          externalRelease(nullptr),
+          allocatedWidth(0),
+          allocatedHeight(0),
+          allocatedChannels(0),
+          allocatedLayout(PixelLayout::Interleaved),
+          allocatedTileSize(0)
     {
     }
 
-    Image::~Image()
+    template <typename T>
+    ImageT<T>::~ImageT()
     {
         freeMemory();
     }
 
     // Establecer paralelización y número de hilos
-    void Image::setParallelization(bool use, int threads)
+    void ImageBase::setParallelization(bool use, int threads)
     {
         useParallelization = use;
         numThreads = threads;
-        
+
         #if defined(_OPENMP)
         if (use) {
             omp_set_num_threads(threads);
@@ -45,248 +220,415 @@ namespace ImageProcessor
         #endif
     }
 
-    // Implementación del constructor de copia
-    Image::Image(const Image &other)
+    // Implementación del constructor de copia: comparte el buffer del original
+    template <typename T>
+    ImageT<T>::ImageT(const ImageT &other)
+        : width(other.width),
+          height(other.height),
+          channels(other.channels),
+          data(other.data),
+          allocationBase(other.allocationBase),
+          layout(other.layout),
+          stride(other.stride),
+          planeStride(other.planeStride),
+          tileSize(other.tileSize),
+          tileOffsets(other.tileOffsets),
+          usingBuddySystem(other.usingBuddySystem),
+          buddySystem(other.buddySystem),
+          totalBufferSize(other.totalBufferSize),
+          references(other.references),
+          externalBuffer(other.externalBuffer),
+          externalRelease(other.externalRelease),
+          allocatedWidth(other.allocatedWidth),
+          allocatedHeight(other.allocatedHeight),
+          allocatedChannels(other.allocatedChannels),
+          allocatedLayout(other.allocatedLayout),
+          allocatedTileSize(other.allocatedTileSize)
+    {
+        if (references)
+        {
+            references->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Implementación del operador de asignación (copia e intercambio: el buffer
+    // anterior se suelta al destruir la copia)
+    template <typename T>
+    ImageT<T> &ImageT<T>::operator=(const ImageT &other)
+    {
+        if (this != &other)
+        {
+            ImageT copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    template <typename T>
+    ImageT<T>::ImageT(ImageT &&other) noexcept
         : width(0),
           height(0),
           channels(0),
-          pixels(nullptr),
+          data(nullptr),
+          allocationBase(nullptr),
+          layout(PixelLayout::Interleaved),
+          stride(0),
+          planeStride(0),
+          tileSize(DEFAULT_TILE_SIZE),
+          tileOffsets(nullptr),
           usingBuddySystem(false),
           buddySystem(nullptr),
-          buddyBuffer(nullptr),
-          totalBufferSize(0)
-    {
-        width    = other.width;
-        height   = other.height;
-        channels = other.channels;
-        usingBuddySystem = other.usingBuddySystem;
-
-        if (width > 0 && height > 0 && channels > 0)
-        {
-            // Usar el mismo método de asignación de memoria que la imagen original
-            allocateMemory(other.usingBuddySystem);
-
-            // Copiar los datos de píxeles
-            const int BLOCK_SIZE = 64; // Tamaño de bloque óptimo para caché
-            
-            #if defined(_OPENMP)
-            if (useParallelization) {
-                #pragma omp parallel for collapse(2) schedule(dynamic, 4)
-                for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
-                    for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
-                        int endY = std::min(blockY + BLOCK_SIZE, height);
-                        int endX = std::min(blockX + BLOCK_SIZE, width);
-                        
-                        for (int y = blockY; y < endY; y++) {
-                            for (int x = blockX; x < endX; x++) {
-                                for (int c = 0; c < channels; c++) {
-                                    pixels[y][x][c] = other.pixels[y][x][c];
-                                }
-                            }
-                        }
-                    }
-                }
-            } else 
-            #endif
-            {
-                for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        for (int c = 0; c < channels; c++) {
-                            pixels[y][x][c] = other.pixels[y][x][c];
-                        }
-                    }
-                }
-            }
-        }
+          totalBufferSize(0),
+          references(nullptr),
+          externalBuffer(false),
+          externalRelease(nullptr),
+          allocatedWidth(0),
+          allocatedHeight(0),
+          allocatedChannels(0),
+          allocatedLayout(PixelLayout::Interleaved),
+          allocatedTileSize(0)
+    {
+        swap(other);
     }
 
-    // Implementación del operador de asignación
-    Image &Image::operator=(const Image &other)
+    template <typename T>
+    ImageT<T> &ImageT<T>::operator=(ImageT &&other) noexcept
     {
         if (this != &other)
         {
+            // Liberar el buffer propio antes de tomar el ajeno
             freeMemory();
-
-            width    = other.width;
-            height   = other.height;
-            channels = other.channels;
-            usingBuddySystem = other.usingBuddySystem;
-
-            if (width > 0 && height > 0 && channels > 0)
-            {
-                // Usar el mismo método de asignación de memoria que la imagen original
-                allocateMemory(other.usingBuddySystem);
-
-                // Copiar los datos de píxeles
-                const int BLOCK_SIZE = 64; // Tamaño de bloque óptimo para caché
-                
-                #if defined(_OPENMP)
-                if (useParallelization) {
-                    #pragma omp parallel for collapse(2) schedule(dynamic, 4)
-                    for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
-                        for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
-                            int endY = std::min(blockY + BLOCK_SIZE, height);
-                            int endX = std::min(blockX + BLOCK_SIZE, width);
-                            
-                            for (int y = blockY; y < endY; y++) {
-                                for (int x = blockX; x < endX; x++) {
-                                    for (int c = 0; c < channels; c++) {
-                                        pixels[y][x][c] = other.pixels[y][x][c];
-                                    }
-                                }
-                            }
-                        }
-                    }
-                } else 
-                #endif
-                {
-                    for (int y = 0; y < height; y++) {
-                        for (int x = 0; x < width; x++) {
-                            for (int c = 0; c < channels; c++) {
-                                pixels[y][x][c] = other.pixels[y][x][c];
-                            }
-                        }
-                    }
-                }
-            }
+            swap(other);
         }
         return *this;
     }
 
-    void Image::allocateMemory(bool useBuddySystem)
+    template <typename T>
+    void ImageT<T>::swap(ImageT &other) noexcept
+    {
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(channels, other.channels);
+        std::swap(data, other.data);
+        std::swap(allocationBase, other.allocationBase);
+        std::swap(layout, other.layout);
+        std::swap(stride, other.stride);
+        std::swap(planeStride, other.planeStride);
+        std::swap(tileSize, other.tileSize);
+        std::swap(tileOffsets, other.tileOffsets);
+        std::swap(usingBuddySystem, other.usingBuddySystem);
+        std::swap(buddySystem, other.buddySystem);
+        std::swap(totalBufferSize, other.totalBufferSize);
+        std::swap(references, other.references);
+        std::swap(externalBuffer, other.externalBuffer);
+        std::swap(externalRelease, other.externalRelease);
+        std::swap(allocatedWidth, other.allocatedWidth);
+        std::swap(allocatedHeight, other.allocatedHeight);
+        std::swap(allocatedChannels, other.allocatedChannels);
+        std::swap(allocatedLayout, other.allocatedLayout);
+        std::swap(allocatedTileSize, other.allocatedTileSize);
+    }
+
+    template <typename T>
+    void ImageT<T>::allocateMemory(bool useBuddySystem)
     {
         // Liberar memoria previa si existe
         freeMemory();
-        
+
         // Establecer el flag de uso de Buddy System
         usingBuddySystem = useBuddySystem;
-        
-        // Calcular el tamaño total necesario
-        totalBufferSize = (size_t)height * width * channels;
-        
-        // Tamaño estimado para punteros de la matriz
-        size_t pointerSize = height * sizeof(unsigned char**) + height * width * sizeof(unsigned char*);
-        
-        if (usingBuddySystem)
+
+        // Cada fila (de cada plano) empieza alineada a una línea de caché
+        const size_t alignment = PIXEL_ALIGNMENT / sizeof(T);
+        size_t rowSamples = (layout == PixelLayout::Planar) ? (size_t)width : (size_t)width * channels;
+        stride = (rowSamples + alignment - 1) / alignment * alignment;
+        size_t tileCount = 0, tileSamples = 0;
+
+        if (layout == PixelLayout::Planar)
         {
-            std::cout << "Asignando memoria usando Buddy System (" << totalBufferSize << " bytes)..." << std::endl;
-            
-            // Crear el sistema Buddy con un tamaño apropiado para la imagen
-            // El tamaño mínimo de bloque es 64 bytes por defecto
-            size_t requiredMemory = totalBufferSize + pointerSize;
-            size_t buddyPoolSize = requiredMemory * 2; // Dar margen extra
-            
-            buddySystem = new MemoryManagement::BuddySystem(buddyPoolSize);
-            
-            // Asignar memoria para la matriz de punteros
-            pixels = (unsigned char***)buddySystem->allocate(height * sizeof(unsigned char**));
-            
-            for (int y = 0; y < height; y++)
-            {
-                pixels[y] = (unsigned char**)buddySystem->allocate(width * sizeof(unsigned char*));
-            }
-            
-            // Asignar un gran bloque para todos los datos de píxeles
-            buddyBuffer = (unsigned char*)buddySystem->allocate(totalBufferSize);
-            
-            // Configurar la matriz 3D para apuntar a las secciones correctas del buffer
-            #if defined(_OPENMP)
-            if (useParallelization) {
-                #pragma omp parallel for schedule(dynamic)
-                for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        pixels[y][x] = &buddyBuffer[(y * width + x) * channels];
-                        
-                        // Inicializar píxeles a 0
-                        for (int c = 0; c < channels; c++) {
-                            pixels[y][x][c] = 0;
-                        }
-                    }
-                }
-            } else 
-            #endif
+            planeStride = (size_t)height * stride;
+            totalBufferSize = planeStride * channels * sizeof(T);
+        }
+        else if (isTiledLayout(layout))
+        {
+            // Los kernels escriben filas de bloques de 32 píxeles dentro de una tesela
+            if (tileSize < 32 || (tileSize & (tileSize - 1)) != 0)
             {
-                for (int y = 0; y < height; y++) {
-                    for (int x = 0; x < width; x++) {
-                        pixels[y][x] = &buddyBuffer[(y * width + x) * channels];
-                        
-                        // Inicializar píxeles a 0
-                        for (int c = 0; c < channels; c++) {
-                            pixels[y][x][c] = 0;
-                        }
-                    }
-                }
+                throw std::invalid_argument("El lado de tesela debe ser una potencia de 2 >= 32");
             }
+
+            // Teselas de tileSize x tileSize píxeles intercalados, seguidas de la
+            // tabla con la posición de cada una (todo en el mismo buffer)
+            stride = (size_t)tileSize * channels;
+            planeStride = 0;
+            tileSamples = (size_t)tileSize * stride;
+            tileCount = (size_t)((width + tileSize - 1) / tileSize) * ((height + tileSize - 1) / tileSize);
+            totalBufferSize = tileCount * tileSamples * sizeof(T) + tileCount * sizeof(size_t);
+        }
+        else
+        {
+            planeStride = 0;
+            totalBufferSize = (size_t)height * stride * sizeof(T);
+        }
+
+        if (totalBufferSize == 0)
+        {
+            return;
+        }
+
+        if (usingBuddySystem)
+        {
+            std::cout << "Asignando memoria usando Buddy System (" << totalBufferSize << " bytes)..." << std::endl;
+
+            // El pool se redondea a la siguiente potencia de 2, de modo que todo el
+            // buffer cabe en un único bloque. La memoria del pool ya está a cero.
+            buddySystem = new MemoryManagement::BuddySystem(totalBufferSize);
+            data = reinterpret_cast<T*>(buddySystem->allocate(totalBufferSize));
         }
         else
         {
             std::cout << "Asignando memoria convencional (" << totalBufferSize << " bytes)..." << std::endl;
 
-            // Asignar memoria para la matriz tridimensional usando new explícitamente
-            pixels = new unsigned char **[height];
-            for (int y = 0; y < height; y++)
+            // Un único bloque alineado para todos los píxeles
+            void *buffer = nullptr;
+            if (posix_memalign(&buffer, PIXEL_ALIGNMENT, totalBufferSize) != 0)
             {
-                pixels[y] = new unsigned char *[width];
-                for (int x = 0; x < width; x++)
-                {
-                    pixels[y][x] = new unsigned char[channels];
-
-                    // Inicializar píxeles a 0
-                    for (int c = 0; c < channels; c++)
-                    {
-                        pixels[y][x][c] = 0;
-                    }
-                }
+                throw std::bad_alloc();
             }
+            data = static_cast<T*>(buffer);
+
+            // Inicializar píxeles a 0
+            memset(data, 0, totalBufferSize);
+        }
+
+        allocationBase = data;
+        references     = new std::atomic<int>(1);
+
+        if (tileCount > 0)
+        {
+            tileOffsets = reinterpret_cast<size_t*>(data + tileCount * tileSamples);
+            fillTileOffsets(tileOffsets, (width + tileSize - 1) / tileSize, (height + tileSize - 1) / tileSize,
+                            tileSamples, layout == PixelLayout::TiledMorton);
         }
+
+        allocatedWidth    = width;
+        allocatedHeight   = height;
+        allocatedChannels = channels;
+        allocatedLayout   = layout;
+        allocatedTileSize = tileSize;
+    }
+
+    template <typename T>
+    void ImageT<T>::ensureMemory(bool useBuddySystem)
+    {
+        if (data && usingBuddySystem == useBuddySystem && allocatedLayout == layout &&
+            allocatedWidth == width && allocatedHeight == height && allocatedChannels == channels &&
+            (!isTiledLayout(layout) || allocatedTileSize == tileSize) && !isShared())
+        {
+            return;
+        }
+
+        allocateMemory(useBuddySystem);
     }
 
-    void Image::freeMemory()
+    template <typename T>
+    void ImageT<T>::freeMemory()
     {
-        if (pixels)
+        // Sólo la última imagen que comparte el buffer lo libera
+        if (data && references->fetch_sub(1, std::memory_order_acq_rel) == 1)
         {
-            if (usingBuddySystem)
+            if (externalBuffer)
+            {
+                if (externalRelease)
+                {
+                    externalRelease(allocationBase);
+                }
+            }
+            else if (usingBuddySystem)
             {
                 if (buddySystem)
                 {
-                    // Liberar el buffer principal
-                    if (buddyBuffer)
-                    {
-                        buddySystem->deallocate(buddyBuffer);
-                        buddyBuffer = nullptr;
-                    }
-                    
-                    // Liberar memoria para los punteros
-                    for (int y = 0; y < height; y++)
-                    {
-                        buddySystem->deallocate((unsigned char*)pixels[y]);
-                    }
-                    
-                    buddySystem->deallocate((unsigned char*)pixels);
-                    
+                    buddySystem->deallocate(reinterpret_cast<unsigned char*>(allocationBase));
                     delete buddySystem;
-                    buddySystem = nullptr;
                 }
             }
             else
             {
-                // Método convencional con new/delete
-                for (int y = 0; y < height; y++)
-                {
-                    for (int x = 0; x < width; x++)
-                    {
-                        delete[] pixels[y][x];
-                    }
-                    delete[] pixels[y];
-                }
-                delete[] pixels;
+                free(allocationBase);
             }
-            
-            pixels = nullptr;
+
+            delete references;
+        }
+
+        data              = nullptr;
+        allocationBase    = nullptr;
+        buddySystem       = nullptr;
+        references        = nullptr;
+        externalBuffer    = false;
+        externalRelease   = nullptr;
+        tileOffsets       = nullptr;
+        allocatedWidth    = 0;
+        allocatedHeight   = 0;
+        allocatedChannels = 0;
+    }
+
+    template <typename T>
+    void ImageT<T>::adoptBuffer(T* buffer, int bufferWidth, int bufferHeight, int bufferChannels,
+                                size_t bufferStride, void (*release)(void*))
+    {
+        freeMemory();
+
+        width            = bufferWidth;
+        height           = bufferHeight;
+        channels         = bufferChannels;
+        layout           = PixelLayout::Interleaved;
+        stride           = bufferStride;
+        planeStride      = 0;
+        usingBuddySystem = false;
+        totalBufferSize  = (size_t)height * stride * sizeof(T);
+
+        data            = buffer;
+        allocationBase  = buffer;
+        externalBuffer  = true;
+        externalRelease = release;
+        references      = new std::atomic<int>(1);
+
+        allocatedWidth    = width;
+        allocatedHeight   = height;
+        allocatedChannels = channels;
+        allocatedLayout   = layout;
+        allocatedTileSize = tileSize;
+    }
+
+    template <typename T>
+    void ImageT<T>::wrapBuffer(T* buffer, int bufferWidth, int bufferHeight, int bufferChannels,
+                               size_t bufferStride)
+    {
+        adoptBuffer(buffer, bufferWidth, bufferHeight, bufferChannels, bufferStride, nullptr);
+    }
+
+    template <typename T>
+    void ImageT<T>::detach()
+    {
+        if (!isShared())
+        {
+            return;
+        }
+
+        ImageT copy;
+        copy.width    = width;
+        copy.height   = height;
+        copy.channels = channels;
+        copy.layout   = layout;
+        copy.tileSize = tileSize;
+        copy.allocateMemory(usingBuddySystem);
+
+        convertLayout(view(), copy.view());
+        *this = std::move(copy);
+    }
+
+    template <typename T>
+    ImageViewT<T> ImageT<T>::view() const
+    {
+        ImageViewT<T> v(data, width, height, channels, stride, planeStride);
+
+        if (tileOffsets)
+        {
+            while ((1 << v.tileShift) < tileSize)
+            {
+                v.tileShift++;
+            }
+            v.tileColumns = (width + tileSize - 1) / tileSize;
+            v.tileOffsets = tileOffsets;
+        }
+
+        return v;
+    }
+
+    // Comprueba que la región (x, y, w, h) está dentro de una imagen de width x height
+    static void checkRegion(int x, int y, int w, int h, int width, int height)
+    {
+        if (x < 0 || y < 0 || w < 0 || h < 0 || x > width - w || y > height - h)
+        {
+            throw std::out_of_range("La región está fuera de la imagen");
+        }
+    }
+
+    template <typename T>
+    ImageViewT<T> ImageT<T>::view(int x, int y, int w, int h) const
+    {
+        checkRegion(x, y, w, h, width, height);
+        return view().region(x, y, w, h);
+    }
+
+    template <typename T>
+    ImageT<T> ImageT<T>::crop(int x, int y, int w, int h) const
+    {
+        checkRegion(x, y, w, h, width, height);
+
+        // En teselas se materializa la región en una imagen nueva con la misma disposición
+        if (isTiledLayout(layout))
+        {
+            ImageT copy;
+            copy.width    = w;
+            copy.height   = h;
+            copy.channels = channels;
+            copy.layout   = layout;
+            copy.tileSize = tileSize;
+            copy.allocateMemory(usingBuddySystem);
+
+            convertLayout(view(x, y, w, h), copy.view());
+            return copy;
+        }
+
+        // Intercalada o planar: compartir el buffer y desplazar el inicio de los píxeles
+        ImageT roi(*this);
+        roi.width  = w;
+        roi.height = h;
+        if (roi.data)
+        {
+            roi.data = view(x, y, w, h).data;
+        }
+
+        roi.allocatedWidth  = w;
+        roi.allocatedHeight = h;
+        return roi;
+    }
+
+    template <typename T>
+    void ImageT<T>::setLayout(PixelLayout newLayout, int newTileSize)
+    {
+        if (newTileSize == 0)
+        {
+            newTileSize = tileSize;
+        }
+
+        if (newLayout == layout && (!isTiledLayout(layout) || newTileSize == tileSize))
+        {
+            return;
+        }
+
+        if (!data)
+        {
+            layout   = newLayout;
+            tileSize = newTileSize;
+            return;
         }
+
+        ImageT converted;
+        converted.width    = width;
+        converted.height   = height;
+        converted.channels = channels;
+        converted.layout   = newLayout;
+        converted.tileSize = newTileSize;
+        converted.allocateMemory(usingBuddySystem);
+
+        convertLayout(view(), converted.view());
+        *this = std::move(converted);
     }
 
-    std::string Image::getInfo() const
+    template <typename T>
+    std::string ImageT<T>::getInfo() const
     {
         std::stringstream ss;
         ss << "Dimensiones: " << width << " x " << height << std::endl;
@@ -310,354 +652,2592 @@ namespace ImageProcessor
         }
 
         ss << ")" << std::endl;
-        ss << "Tamaño en memoria: " << (width * height * channels / 1024.0) << " KB" << std::endl;
-        ss << "Método de asignación: " << (usingBuddySystem ? "Buddy System" : "Convencional");
+        ss << "Muestras: " << SampleTraits<T>::name() << std::endl;
+        ss << "Tamaño en memoria: " << (width * height * channels * sizeof(T) / 1024.0) << " KB" << std::endl;
+        ss << "Método de asignación: " << (usingBuddySystem ? "Buddy System" : "Convencional") << std::endl;
+        ss << "Disposición: ";
+
+        switch (layout)
+        {
+            case PixelLayout::Planar:
+                ss << "Planar (un plano por canal)";
+                break;
+            case PixelLayout::Tiled:
+                ss << "Teselas de " << tileSize << " x " << tileSize << " (orden por filas)";
+                break;
+            case PixelLayout::TiledMorton:
+                ss << "Teselas de " << tileSize << " x " << tileSize << " (orden Z / Morton)";
+                break;
+            default:
+                ss << "Intercalada";
+                break;
+        }
 
         return ss.str();
     }
 
-    std::string Image::getMemoryStats() const
+    template <typename T>
+    std::string ImageT<T>::getMemoryStats() const
     {
         std::stringstream ss;
-        
+
         if (usingBuddySystem && buddySystem)
         {
             MemoryManagement::BuddySystem::MemoryStats stats = buddySystem->getStats();
-            
+
             ss << "  Memoria total: " << stats.totalMemory << " bytes" << std::endl;
+            ss << "  Memoria residente: " << stats.residentMemory << " bytes" << std::endl;
+            if (stats.lazyFreeMemory > 0)
+            {
+                ss << "  Memoria marcada con MADV_FREE: " << stats.lazyFreeMemory << " bytes" << std::endl;
+            }
         }
-        
+
         return ss.str();
     }
 
-    // Función optimizada para bilinearInterpolation
-    unsigned char Image::bilinearInterpolation(float x, float y, int channel) {
-        // Si las coordenadas están fuera de la imagen, devolver 0 (negro)
-        if (x < 0 || y < 0 || x >= width - 1 || y >= height - 1) {
-            return 0;
-        }  
-
-        // Obtener los índices de los píxeles vecinos
-        int x1 = static_cast<int>(x);
-        int y1 = static_cast<int>(y);
-        int x2 = x1 + 1;
-        int y2 = y1 + 1;
+    // Vecinos (x1, y1), (x1+1, y1), (x1, y1+1) y (x1+1, y1+1) en disposición en
+    // teselas. Sólo en el borde derecho o inferior de una tesela hay que buscar el
+    // vecino en otra; en el resto están a un píxel o a una fila de tesela.
+    template <typename T>
+    static inline void tiledNeighbours(const ImageViewT<T> &src, int x1, int y1,
+                                       const T *&p00, const T *&p10, const T *&p01, const T *&p11)
+    {
+        const int mask = (1 << src.tileShift) - 1;
+        const bool lastColumn = ((x1 + src.originX) & mask) == mask;
+        const bool lastRow    = ((y1 + src.originY) & mask) == mask;
 
-        // Pre-calcular todos los pesos de una vez
-        float dx = x - x1;
-        float dy = y - y1;
-        float w1 = (1.0f - dx) * (1.0f - dy);
-        float w2 = dx * (1.0f - dy);
-        float w3 = (1.0f - dx) * dy;
-        float w4 = dx * dy;
+        p00 = src.tiledPixel(x1, y1);
+        p10 = lastColumn ? src.tiledPixel(x1 + 1, y1) : p00 + src.channels;
+        p01 = lastRow ? src.tiledPixel(x1, y1 + 1) : p00 + src.stride;
+        p11 = (lastColumn || lastRow) ? src.tiledPixel(x1 + 1, y1 + 1) : p01 + src.channels;
+    }
 
-        // Acceso a memoria más eficiente
-        unsigned char p1 = pixels[y1][x1][channel];
-        unsigned char p2 = pixels[y1][x2][channel];
-        unsigned char p3 = pixels[y2][x1][channel];
-        unsigned char p4 = pixels[y2][x2][channel];
+    // Posiciones de origen en coma fija para el avance incremental (DDA) de los
+    // kernels: 16 bits de fracción sobre 64 bits, sin desbordes aunque la
+    // posición caiga muy lejos de la imagen
+    const int FIXED_SHIFT = 16;
+    const int64_t FIXED_ONE = int64_t(1) << FIXED_SHIFT;
+    const float FIXED_SCALE = 1.0f / FIXED_ONE;
 
-        // Cálculo más eficiente
-        float value = w1 * p1 + w2 * p2 + w3 * p3 + w4 * p4;
-    
-        return static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, value)));
+    static inline int64_t toFixed(double value)
+    {
+        return static_cast<int64_t>(std::floor(value * FIXED_ONE + 0.5));
     }
 
-    // Nueva función para procesamiento por bloques
-    void Image::bilinearInterpolationBlock(float* srcX, float* srcY, int startX, int startY, 
-                                          int blockWidth, int blockHeight, unsigned char* output) {
-        for (int y = 0; y < blockHeight; y++) {
-            for (int x = 0; x < blockWidth; x++) {
-                int outIdx = (y * blockWidth + x) * channels;
-                float xPos = srcX[y * blockWidth + x];
-                float yPos = srcY[y * blockWidth + x];
-                
-                // Si está fuera de la imagen, poner negro
-                if (xPos < 0 || yPos < 0 || xPos >= width - 1 || yPos >= height - 1) {
-                    for (int c = 0; c < channels; c++) {
-                        output[outIdx + c] = 0;
-                    }
-                    continue;
-                }
-                
-                // Calcular índices y pesos
-                int x1 = static_cast<int>(xPos);
-                int y1 = static_cast<int>(yPos);
-                int x2 = x1 + 1;
-                int y2 = y1 + 1;
-                
-                float dx = xPos - x1;
-                float dy = yPos - y1;
-                float w1 = (1.0f - dx) * (1.0f - dy);
-                float w2 = dx * (1.0f - dy);
-                float w3 = (1.0f - dx) * dy;
-                float w4 = dx * dy;
-                
-                // Procesar todos los canales
-                for (int c = 0; c < channels; c++) {
-                    unsigned char p1 = pixels[y1][x1][c];
-                    unsigned char p2 = pixels[y1][x2][c];
-                    unsigned char p3 = pixels[y2][x1][c];
-                    unsigned char p4 = pixels[y2][x2][c];
-                    
-                    float value = w1 * p1 + w2 * p2 + w3 * p3 + w4 * p4;
-                    output[outIdx + c] = static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, value)));
-                }
-            }
-        }
+    // Fracción en [0, 1) de una posición float, en coma fija
+    static inline uint32_t toFraction(float fraction)
+    {
+        return static_cast<uint32_t>(fraction * FIXED_ONE + 0.5f);
     }
 
-    void Image::rotateImage(float angleDegrees)
+    // Pesos enteros de la interpolación para cada tipo de muestra: BITS bits de
+    // fracción y un acumulador donde caben los productos de las dos pasadas sin
+    // desbordar (255 * 2^8 * 2^8 en 32 bits, 65535 * 2^16 * 2^16 en 64 bits).
+    // Partial guarda el resultado de la pasada horizontal sin redondear (resize).
+    // BITS = 0: sin ruta entera (muestras float).
+    template <typename T>
+    struct FixedWeights
     {
-        // Convertir ángulo de grados a radianes
-        float angleRadians = angleDegrees * M_PI / 180.0f;
-    
-        // Crear una nueva imagen con las mismas dimensiones para almacenar el resultado
-        Image rotatedImage;
-        rotatedImage.width    = width;
-        rotatedImage.height   = height;
-        rotatedImage.channels = channels;
-        rotatedImage.allocateMemory(usingBuddySystem); // Usar el mismo método de memoria
-    
-        // Calcular el centro de la imagen
-        float centerX = width / 2.0f;
-        float centerY = height / 2.0f;
-    
-        // Calcular la matriz de rotación inversa
-        float cosAngle = cos(angleRadians);
-        float sinAngle = sin(angleRadians);
-    
-        // Optimizado: procesar la imagen en bloques para mejor uso de caché
-        const int BLOCK_SIZE = 32; // Tamaño óptimo para rotación
-    
-        // Buffers para coordenadas de origen pre-calculadas
-        float* srcX = new float[BLOCK_SIZE * BLOCK_SIZE];
-        float* srcY = new float[BLOCK_SIZE * BLOCK_SIZE];
-        unsigned char* outBuffer = new unsigned char[BLOCK_SIZE * BLOCK_SIZE * channels];
-    
+        static const int BITS = 0;
+        typedef uint32_t Accumulator;
+        typedef uint32_t Partial;
+    };
+
+    template <>
+    struct FixedWeights<uint8_t>
+    {
+        static const int BITS = 8;
+        typedef uint32_t Accumulator;
+        typedef uint16_t Partial;
+    };
+
+    template <>
+    struct FixedWeights<uint16_t>
+    {
+        static const int BITS = 16;
+        typedef uint64_t Accumulator;
+        typedef uint32_t Partial;
+    };
+
+    // Interpolación en enteros: primero en horizontal y después en vertical, con
+    // los pesos redondeados a FixedWeights<T>::BITS bits. El resultado se trunca
+    // igual que SampleTraits::fromFloat y queda a +-1 del cálculo en float.
+    template <int C, typename T>
+    static inline void bilinearTapsInteger(const T *p00, const T *p10, const T *p01, const T *p11,
+                                           uint32_t fracX, uint32_t fracY, int channels, T *out)
+    {
+        typedef typename FixedWeights<T>::Accumulator Accumulator;
+        const int bits = FixedWeights<T>::BITS;
+        const int drop = FIXED_SHIFT - bits;
+        const uint32_t half = (1u << drop) >> 1;
+        const Accumulator one = Accumulator(1) << bits;
+        const Accumulator wx = (fracX + half) >> drop;
+        const Accumulator wy = (fracY + half) >> drop;
+
+        for (int c = 0; c < channels; c++) {
+            Accumulator top    = p00[c] * (one - wx) + p10[c] * wx;
+            Accumulator bottom = p01[c] * (one - wx) + p11[c] * wx;
+            out[c] = static_cast<T>((top * (one - wy) + bottom * wy) >> (2 * bits));
+        }
+    }
+
+    // Combina los cuatro vecinos con los pesos de la fracción (fracX, fracY, en coma
+    // fija) en todos los canales. C fijo (1-4) permite desenrollar el bucle de
+    // canales. integer elige la ruta entera (sólo con muestras enteras).
+    template <int C, typename T>
+    static inline void bilinearTaps(const T *p00, const T *p10, const T *p01, const T *p11,
+                                    uint32_t fracX, uint32_t fracY, int channels, bool integer, T *out)
+    {
+        if (FixedWeights<T>::BITS > 0 && integer) {
+            bilinearTapsInteger<C>(p00, p10, p01, p11, fracX, fracY, channels, out);
+            return;
+        }
+
+        float dx = fracX * FIXED_SCALE;
+        float dy = fracY * FIXED_SCALE;
+        float w1 = (1.0f - dx) * (1.0f - dy);
+        float w2 = dx * (1.0f - dy);
+        float w3 = (1.0f - dx) * dy;
+        float w4 = dx * dy;
+
+        for (int c = 0; c < channels; c++) {
+            float value = w1 * p00[c] + w2 * p10[c] + w3 * p01[c] + w4 * p11[c];
+            out[c] = SampleTraits<T>::fromFloat(value);
+        }
+    }
+
+    // Función optimizada para la interpolación bilineal
+    template <typename T>
+    T bilinearSample(const ImageViewT<T> &src, float x, float y, int channel)
+    {
+        if (src.isPlanar()) {
+            return bilinearSample(src.plane(channel), x, y, 0);
+        }
+
+        // Si las coordenadas están fuera de la imagen, devolver 0 (negro)
+        if (x < 0 || y < 0 || x >= src.width - 1 || y >= src.height - 1) {
+            return 0;
+        }
+
+        // Obtener los índices de los píxeles vecinos
+        int x1 = static_cast<int>(x);
+        int y1 = static_cast<int>(y);
+
+        // Sin teselas, los cuatro vecinos están en dos filas contiguas
+        const T *p00, *p10, *p01, *p11;
+        if (src.isTiled()) {
+            tiledNeighbours(src, x1, y1, p00, p10, p01, p11);
+        } else {
+            p00 = src.pixel(x1, y1);
+            p10 = p00 + src.channels;
+            p01 = p00 + src.stride;
+            p11 = p01 + src.channels;
+        }
+
+        T value;
+        bilinearTaps<1>(p00 + channel, p10 + channel, p01 + channel, p11 + channel,
+                        toFraction(x - x1), toFraction(y - y1), 1, ImageBase::useIntegerInterpolation, &value);
+        return value;
+    }
+
+    template <typename T>
+    T ImageT<T>::bilinearInterpolation(float x, float y, int channel) const
+    {
+        return bilinearSample(view(), x, y, channel);
+    }
+
+    // Interpola todos los canales de un píxel de destino a partir de la posición de
+    // origen. C fijo (1-4) permite desenrollar el bucle de canales; C = 0 usa src.channels
+    template <int C, typename T>
+    static inline void bilinearPixel(const ImageViewT<T> &src, float xPos, float yPos, bool integer, T *out)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+
+        // Si está fuera de la imagen, poner negro
+        if (xPos < 0 || yPos < 0 || xPos >= src.width - 1 || yPos >= src.height - 1) {
+            for (int c = 0; c < channels; c++) {
+                out[c] = 0;
+            }
+            return;
+        }
+
+        // Calcular índices y pesos
+        int x1 = static_cast<int>(xPos);
+        int y1 = static_cast<int>(yPos);
+
+        const T *top    = src.pixel(x1, y1);
+        const T *bottom = top + src.stride;
+
+        // Procesar todos los canales
+        bilinearTaps<C>(top, top + channels, bottom, bottom + channels,
+                        toFraction(xPos - x1), toFraction(yPos - y1), channels, integer, out);
+    }
+
+    // Igual que bilinearPixel con la posición en coma fija, con el origen
+    // intercalado o en teselas. Sin comprobar los límites: la posición debe tener
+    // sus cuatro vecinos dentro de src (ver validSpan)
+    template <int C, bool Tiled, typename T>
+    static inline void bilinearFixedPixel(const ImageViewT<T> &src, int64_t fx, int64_t fy, bool integer, T *out)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        const int64_t x1 = fx >> FIXED_SHIFT;
+        const int64_t y1 = fy >> FIXED_SHIFT;
+
+        const T *p00, *p10, *p01, *p11;
+        if (Tiled) {
+            tiledNeighbours(src, (int)x1, (int)y1, p00, p10, p01, p11);
+        } else {
+            p00 = src.pixel((int)x1, (int)y1);
+            p10 = p00 + channels;
+            p01 = p00 + src.stride;
+            p11 = p01 + channels;
+        }
+        bilinearTaps<C>(p00, p10, p01, p11, (uint32_t)(fx & (FIXED_ONE - 1)), (uint32_t)(fy & (FIXED_ONE - 1)),
+                        channels, integer, out);
+    }
+
+    // Índice del vecino i de un eje de size píxeles según el modo de borde; -1 si
+    // cae fuera con BorderMode::Constant
+    static inline int borderIndex(int i, int size, BorderMode mode)
+    {
+        if (i >= 0 && i < size) {
+            return i;
+        }
+
+        switch (mode) {
+            case BorderMode::Clamp:
+                return i < 0 ? 0 : size - 1;
+            case BorderMode::Reflect: {
+                const int period = 2 * size;
+                i %= period;
+                i = (i < 0) ? i + period : i;
+                return i < size ? i : period - 1 - i;
+            }
+            case BorderMode::Wrap:
+                i %= size;
+                return (i < 0) ? i + size : i;
+            default:
+                return -1;
+        }
+    }
+
+    // Vecino (x, y) de src según el modo de borde: constant (un píxel con el color
+    // de BorderMode::Constant) si cae fuera de la imagen
+    template <typename T>
+    static inline const T *borderPixel(const ImageViewT<T> &src, int x, int y, BorderMode mode, const T *constant)
+    {
+        x = borderIndex(x, src.width, mode);
+        y = borderIndex(y, src.height, mode);
+        return (x < 0 || y < 0) ? constant : src.pixelAt(x, y);
+    }
+
+    // Memoria temporal de los kernels: tablas por columna y por fila, pesos y filas
+    // intermedias son static thread_local y conservan su capacidad entre llamadas,
+    // así que repetir una operación con la misma geometría no reserva memoria (ver
+    // ImageT::rotateTo). Todas miden como mucho una fila o una tabla por eje; las
+    // que se leen dentro de una región paralela se pasan por una referencia local,
+    // que apunta a la del hilo que llama.
+
+    // Color de BorderMode::Constant en el tipo de muestra, un valor por canal
+    template <typename T>
+    static const std::vector<T> &borderConstant(int channels)
+    {
+        static thread_local std::vector<T> constant;
+        constant.resize(std::max(channels, 1));
+        for (size_t c = 0; c < constant.size(); c++) {
+            const float value = ImageBase::borderColor[std::min<size_t>(c, 3)] * SampleTraits<T>::white();
+            constant[c] = SampleTraits<T>::fromFloat(std::is_integral<T>::value ? value + 0.5f : value);
+        }
+        return constant;
+    }
+
+    // Rellena n píxeles de channels muestras con pixel
+    template <typename T>
+    static inline void fillPixels(T *out, int n, const T *pixel, int channels)
+    {
+        // Todas las muestras iguales (el negro por defecto): relleno directo
+        if (std::count(pixel, pixel + channels, pixel[0]) == channels) {
+            std::fill(out, out + (size_t)n * channels, pixel[0]);
+            return;
+        }
+
+        for (int i = 0; i < n; i++, out += channels) {
+            for (int c = 0; c < channels; c++) {
+                out[c] = pixel[c];
+            }
+        }
+    }
+
+    // bilinearFixedPixel para las posiciones [begin, end) de una fila (fx + i *
+    // stepX, fy + i * stepY) con vecinos fuera de src, que se resuelven con el modo
+    // de borde. src intercalada, en teselas o un único plano; out es el inicio de
+    // la fila.
+    template <int C, typename T>
+    static void bilinearBorderRow(const ImageViewT<T> &src, int64_t fx, int64_t fy, int64_t stepX, int64_t stepY,
+                                  int begin, int end, bool integer, BorderMode mode, const T *constant, T *out)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        fx += begin * stepX;
+        fy += begin * stepY;
+        out += (size_t)begin * channels;
+
+        for (int i = begin; i < end; i++, fx += stepX, fy += stepY, out += channels) {
+            const int x1 = (int)(fx >> FIXED_SHIFT);
+            const int y1 = (int)(fy >> FIXED_SHIFT);
+            bilinearTaps<C>(borderPixel(src, x1, y1, mode, constant), borderPixel(src, x1 + 1, y1, mode, constant),
+                            borderPixel(src, x1, y1 + 1, mode, constant),
+                            borderPixel(src, x1 + 1, y1 + 1, mode, constant), (uint32_t)(fx & (FIXED_ONE - 1)),
+                            (uint32_t)(fy & (FIXED_ONE - 1)), channels, integer, out);
+        }
+    }
+
+    // Interpola n píxeles de un único plano a partir de posiciones en coma fija,
+    // todas con sus cuatro vecinos dentro del plano (ver validSpan). Sin bucle por
+    // canal y sin saltos, de modo que un compilador con gathers de bytes puede
+    // vectorizar un vector completo del canal (GCC 12 todavía lo deja escalar).
+    template <typename T>
+    static inline void bilinearPlaneRow(const ImageViewT<T> &plane, const int64_t *xs, const int64_t *ys,
+                                        int n, bool integer, T *out)
+    {
+        const T *base = plane.data;
+        const size_t stride = plane.stride;
+
+        for (int i = 0; i < n; i++) {
+            const T *top = base + (ys[i] >> FIXED_SHIFT) * stride + (xs[i] >> FIXED_SHIFT);
+            bilinearTaps<1>(top, top + 1, top + stride, top + stride + 1, (uint32_t)(xs[i] & (FIXED_ONE - 1)),
+                            (uint32_t)(ys[i] & (FIXED_ONE - 1)), 1, integer, out + i);
+        }
+    }
+
+    template <int C, typename T>
+    static void bilinearBlock(const ImageViewT<T> &src, const float *srcX, const float *srcY, int count, T *output)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        const bool integer = ImageBase::useIntegerInterpolation;
+
+        for (int idx = 0; idx < count; idx++) {
+            bilinearPixel<C>(src, srcX[idx], srcY[idx], integer, output + idx * channels);
+        }
+    }
+
+    // Nueva función para procesamiento por bloques
+    template <typename T>
+    void ImageT<T>::bilinearInterpolationBlock(float* srcX, float* srcY, int startX, int startY,
+                                          int blockWidth, int blockHeight, T* output) const {
+        ImageViewT<T> src = view();
+        int count = blockWidth * blockHeight;
+
+        switch (channels) {
+            case 1:  bilinearBlock<1>(src, srcX, srcY, count, output); break;
+            case 2:  bilinearBlock<2>(src, srcX, srcY, count, output); break;
+            case 3:  bilinearBlock<3>(src, srcX, srcY, count, output); break;
+            case 4:  bilinearBlock<4>(src, srcX, srcY, count, output); break;
+            default: bilinearBlock<0>(src, srcX, srcY, count, output); break;
+        }
+    }
+
+    AffineTransform AffineTransform::identity()
+    {
+        AffineTransform t = {{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::translation(float tx, float ty)
+    {
+        AffineTransform t = {{1.0f, 0.0f, tx, 0.0f, 1.0f, ty}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::scaling(float sx, float sy)
+    {
+        AffineTransform t = {{sx, 0.0f, 0.0f, 0.0f, sy, 0.0f}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::shear(float shx, float shy)
+    {
+        AffineTransform t = {{1.0f, shx, 0.0f, shy, 1.0f, 0.0f}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::rotation(float angleDegrees, float cx, float cy)
+    {
+        // Convertir ángulo de grados a radianes
+        float angleRadians = angleDegrees * M_PI / 180.0f;
+        float cosAngle = cos(angleRadians);
+        float sinAngle = sin(angleRadians);
+
+        // Trasladar el centro al origen, rotar y volver a trasladar
+        AffineTransform t = {{cosAngle, -sinAngle, cx - cosAngle * cx + sinAngle * cy,
+                              sinAngle, cosAngle, cy - sinAngle * cx - cosAngle * cy}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::then(const AffineTransform &next) const
+    {
+        const float *a = next.m;
+        AffineTransform t = {{a[0] * m[0] + a[1] * m[3], a[0] * m[1] + a[1] * m[4], a[0] * m[2] + a[1] * m[5] + a[2],
+                              a[3] * m[0] + a[4] * m[3], a[3] * m[1] + a[4] * m[4], a[3] * m[2] + a[4] * m[5] + a[5]}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::inverse() const
+    {
+        // Determinante calculado en double: las matrices casi singulares (escalas
+        // muy pequeñas) pierden menos precisión
+        double det = (double)m[0] * m[4] - (double)m[1] * m[3];
+        if (det == 0.0)
+        {
+            throw std::invalid_argument("La transformación afín no es invertible");
+        }
+
+        double a = m[4] / det, b = -m[1] / det;
+        double c = -m[3] / det, d = m[0] / det;
+        AffineTransform t = {{(float)a, (float)b, (float)(-a * m[2] - b * m[5]),
+                              (float)c, (float)d, (float)(-c * m[2] - d * m[5])}};
+        return t;
+    }
+
+    AffineTransform AffineTransform::expandCanvas(int width, int height, int &outWidth, int &outHeight) const
+    {
+        const float cornersX[] = {0.0f, (float)width, 0.0f, (float)width};
+        const float cornersY[] = {0.0f, 0.0f, (float)height, (float)height};
+        float minX = 0, minY = 0, maxX = 0, maxY = 0;
+
+        for (int i = 0; i < 4; i++)
+        {
+            float x, y;
+            apply(cornersX[i], cornersY[i], x, y);
+            minX = (i == 0) ? x : std::min(minX, x);
+            maxX = (i == 0) ? x : std::max(maxX, x);
+            minY = (i == 0) ? y : std::min(minY, y);
+            maxY = (i == 0) ? y : std::max(maxY, y);
+        }
+
+        // Redondear a píxeles enteros para que el contenido no se desplace medio píxel
+        minX = std::floor(minX);
+        minY = std::floor(minY);
+        outWidth  = static_cast<int>(std::ceil(maxX - minX));
+        outHeight = static_cast<int>(std::ceil(maxY - minY));
+        return then(translation(-minX, -minY));
+    }
+
+    // Kernel vectorial de filas para src (ver bilinear_simd.h): sólo muestras de 8
+    // bits intercaladas y ruta entera, con la que es idéntico bit a bit
+    template <typename T>
+    static inline BilinearSimd::RowKernel simdRowKernel(const ImageViewT<T> &, bool)
+    {
+        return nullptr;
+    }
+
+    static inline BilinearSimd::RowKernel simdRowKernel(const ImageView &src, bool integer)
+    {
+        if (!integer || src.isPlanar() || src.isTiled() || src.width < 2 || src.height < 2 ||
+            (uint64_t)src.height * src.stride >= (uint64_t)INT32_MAX) {
+            return nullptr;
+        }
+        return BilinearSimd::rowKernel(ImageBase::simdLevel, src.channels);
+    }
+
+    // Interpola n píxeles de una fila con el kernel vectorial. Devuelve false si
+    // las posiciones no caben en 32 bits (el llamador usa la ruta escalar).
+    template <typename T>
+    static inline bool simdRow(BilinearSimd::RowKernel, const ImageViewT<T> &, int64_t, int64_t,
+                               int64_t, int64_t, int, T *)
+    {
+        return false;
+    }
+
+    static inline bool simdRow(BilinearSimd::RowKernel kernel, const ImageView &src, int64_t fx, int64_t fy,
+                               int64_t stepX, int64_t stepY, int n, uint8_t *out)
+    {
+        // El kernel avanza hasta 16 píxeles más allá de n; con todo acotado a 2^30
+        // ni las posiciones ni los pasos acumulados desbordan 32 bits
+        const int64_t limit = int64_t(1) << 30;
+        const int64_t spanX = stepX * (n + 16);
+        const int64_t spanY = stepY * (n + 16);
+        if (fx <= -limit || fx >= limit || fy <= -limit || fy >= limit ||
+            spanX <= -limit || spanX >= limit || spanY <= -limit || spanY >= limit) {
+            return false;
+        }
+
+        kernel(src.data, (int)src.stride, src.width, src.height, (int32_t)fx, (int32_t)fy,
+               (int32_t)stepX, (int32_t)stepY, n, out);
+        return true;
+    }
+
+    // División entera redondeando hacia abajo / arriba (divisor positivo)
+    static inline int64_t floorDiv(int64_t a, int64_t b)
+    {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    static inline int64_t ceilDiv(int64_t a, int64_t b)
+    {
+        return -floorDiv(-a, b);
+    }
+
+    // Tramo [begin, end) de los índices i en [0, n) con lo <= f + i * step < hi
+    // en un eje, calculado directamente en lugar de comprobar píxel a píxel
+    static inline void axisSpan(int64_t f, int64_t step, int64_t lo, int64_t hi, int n, int64_t &begin, int64_t &end)
+    {
+        if (step == 0) {
+            begin = 0;
+            end = (f >= lo && f < hi) ? n : 0;
+        } else if (step > 0) {
+            begin = ceilDiv(lo - f, step);
+            end = floorDiv(hi - 1 - f, step) + 1;
+        } else {
+            begin = ceilDiv(f - hi + 1, -step);
+            end = floorDiv(f - lo, -step) + 1;
+        }
+        begin = std::min<int64_t>(std::max<int64_t>(begin, 0), n);
+        end = std::min<int64_t>(end, n);
+    }
+
+    // Posiciones en coma fija de un eje de src para un filtro de radius vecinos a
+    // cada lado (1: bilineal): en [innerLo, innerHi) todos los vecinos caen dentro
+    // de la imagen y fuera de [outerLo, outerHi) ninguno
+    struct AxisBounds
+    {
+        int64_t innerLo, innerHi;
+        int64_t outerLo, outerHi;
+    };
+
+    static inline AxisBounds axisBounds(int size, int radius)
+    {
+        AxisBounds bounds;
+        bounds.innerLo = (int64_t)(radius - 1) * FIXED_ONE;
+        bounds.innerHi = (int64_t)(size - radius) * FIXED_ONE;
+        bounds.outerLo = -(int64_t)radius * FIXED_ONE;
+        bounds.outerHi = (int64_t)(size - 1 + radius) * FIXED_ONE;
+        return bounds;
+    }
+
+    // Tramo de una fila de n píxeles (desde (fx, fy) con paso (stepX, stepY)) cuyas
+    // posiciones cumplen loX <= fx < hiX y loY <= fy < hiY
+    static inline void validSpan(int64_t fx, int64_t fy, int64_t stepX, int64_t stepY, int64_t loX, int64_t hiX,
+                                 int64_t loY, int64_t hiY, int n, int &begin, int &end)
+    {
+        int64_t beginX, endX, beginY, endY;
+        axisSpan(fx, stepX, loX, hiX, n, beginX, endX);
+        axisSpan(fy, stepY, loY, hiY, n, beginY, endY);
+        begin = (int)std::max(beginX, beginY);
+        end = (int)std::max<int64_t>(std::min(endX, endY), begin);
+    }
+
+    // Clasificación de un bloque de dst por las posiciones de sus cuatro esquinas
+    enum class BlockCoverage
+    {
+        Inside,  // todos los vecinos de todas las posiciones dentro de src
+        Outside, // ningún vecino dentro (sólo con BorderMode::Constant): color constante
+        Border   // mezcla: cada fila se parte con rowSpans
+    };
+
+    // Las esquinas se calculan igual que en los kernels (anclas de la primera y la
+    // última fila más el avance de la fila); las filas intermedias quedan entre
+    // ellas salvo el redondeo del ancla, de ahí la holgura de una unidad.
+    static BlockCoverage classifyBlock(const float *m, int blockX, int blockY, int blockW, int blockH,
+                                       int64_t stepX, int64_t stepY, const AxisBounds &boundsX,
+                                       const AxisBounds &boundsY, bool constant)
+    {
+        int64_t minX = 0, maxX = 0, minY = 0, maxY = 0;
+        for (int corner = 0; corner < 4; corner++) {
+            const int y = blockY + ((corner & 2) ? blockH - 1 : 0);
+            const int64_t advance = (corner & 1) ? blockW - 1 : 0;
+            const int64_t fx = toFixed((double)m[0] * blockX + (double)m[1] * y + m[2]) + advance * stepX;
+            const int64_t fy = toFixed((double)m[3] * blockX + (double)m[4] * y + m[5]) + advance * stepY;
+            minX = (corner == 0) ? fx : std::min(minX, fx);
+            maxX = (corner == 0) ? fx : std::max(maxX, fx);
+            minY = (corner == 0) ? fy : std::min(minY, fy);
+            maxY = (corner == 0) ? fy : std::max(maxY, fy);
+        }
+
+        if (constant && (maxX + 1 < boundsX.outerLo || maxY + 1 < boundsY.outerLo ||
+                         minX > boundsX.outerHi || minY > boundsY.outerHi)) {
+            return BlockCoverage::Outside;
+        }
+        if (minX > boundsX.innerLo && minY > boundsY.innerLo &&
+            maxX + 1 < boundsX.innerHi && maxY + 1 < boundsY.innerHi) {
+            return BlockCoverage::Inside;
+        }
+        return BlockCoverage::Border;
+    }
+
+    // Partición de una fila de n píxeles de un bloque: [0, outerBegin) y
+    // [outerEnd, n) toman el color constante, [innerBegin, innerEnd) tiene todos
+    // los vecinos dentro de src y el resto pasa por el modo de borde
+    struct RowSpans
+    {
+        int outerBegin, innerBegin, innerEnd, outerEnd;
+    };
+
+    static inline RowSpans rowSpans(BlockCoverage coverage, int64_t fx, int64_t fy, int64_t stepX, int64_t stepY,
+                                    const AxisBounds &boundsX, const AxisBounds &boundsY, bool constant, int n)
+    {
+        RowSpans spans = {0, 0, n, n};
+        if (coverage == BlockCoverage::Outside) {
+            spans.innerBegin = spans.innerEnd = spans.outerEnd = 0;
+        } else if (coverage == BlockCoverage::Border) {
+            if (constant) {
+                validSpan(fx, fy, stepX, stepY, boundsX.outerLo, boundsX.outerHi, boundsY.outerLo, boundsY.outerHi,
+                          n, spans.outerBegin, spans.outerEnd);
+            }
+            validSpan(fx, fy, stepX, stepY, boundsX.innerLo, boundsX.innerHi, boundsY.innerLo, boundsY.innerHi,
+                      n, spans.innerBegin, spans.innerEnd);
+            if (spans.innerBegin >= spans.innerEnd) {
+                spans.innerBegin = spans.innerEnd = spans.outerEnd;
+            }
+        }
+        return spans;
+    }
+
+    // Transformación afín con C canales fijos en compilación (0: número de canales
+    // en ejecución). inverse lleva cada píxel de dst a su posición en src.
+    template <int C, typename T>
+    static void affineKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, const AffineTransform &inverse)
+    {
+        const int channels = (C > 0) ? C : dst.channels;
+        const float *m = inverse.m;
+
+        // A lo largo de una fila de dst la posición de origen avanza (m[0], m[3])
+        // por píxel: se recorre sumando ese paso en coma fija en lugar de evaluar
+        // la matriz en cada píxel
+        const int64_t stepX = toFixed(m[0]);
+        const int64_t stepY = toFixed(m[3]);
+
+        // Pesos enteros con muestras de 8 y 16 bits (ver bilinearTapsInteger)
+        const bool integer = ImageBase::useIntegerInterpolation;
+
+        // Filas de 8 bits con 3 o 4 canales: kernel SSE4.1/AVX2/AVX-512 (nullptr si no aplica)
+        const BilinearSimd::RowKernel simd = simdRowKernel(src, integer);
+
+        // Optimizado: procesar la imagen en bloques para mejor uso de caché
+        const int BLOCK_SIZE = 32; // Tamaño óptimo para rotación y escalado
+
+        // Columnas de bloques alineadas con las teselas de dst: una región de una
+        // vista en teselas puede empezar a mitad de tesela
+        const int gridOffset = dst.isTiled() ? (dst.originX & (BLOCK_SIZE - 1)) : 0;
+
+        // Cada bloque se clasifica por sus esquinas: los de dentro interpolan sin
+        // comprobar límites, los de fuera toman el color constante y sólo los del
+        // borde parten cada fila en tramos (ver rowSpans)
+        const BorderMode mode = ImageBase::borderMode;
+        const bool constantMode = mode == BorderMode::Constant;
+        const std::vector<T> &constant = borderConstant<T>(src.channels);
+        const AxisBounds boundsX = axisBounds(src.width, 1);
+        const AxisBounds boundsY = axisBounds(src.height, 1);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(dynamic, 4) if(ImageBase::useParallelization)
+        #endif
+        for (int blockY = 0; blockY < dst.height; blockY += BLOCK_SIZE) {
+            for (int gridX = 0; gridX < dst.width + gridOffset; gridX += BLOCK_SIZE) {
+                // Definir los límites del bloque
+                int blockX = std::max(0, gridX - gridOffset);
+                int endY = std::min(blockY + BLOCK_SIZE, dst.height);
+                int endX = std::min(gridX - gridOffset + BLOCK_SIZE, dst.width);
+                int blockW = endX - blockX;
+
+                const BlockCoverage coverage = classifyBlock(m, blockX, blockY, blockW, endY - blockY, stepX, stepY,
+                                                             boundsX, boundsY, constantMode);
+
+                for (int y = blockY; y < endY; y++) {
+                    // Reanclar al inicio de cada fila del bloque (calculado en double): el
+                    // error del avance incremental no se acumula más de BLOCK_SIZE pasos
+                    const int64_t rowX = toFixed((double)m[0] * blockX + (double)m[1] * y + m[2]);
+                    const int64_t rowY = toFixed((double)m[3] * blockX + (double)m[4] * y + m[5]);
+
+                    const RowSpans spans = rowSpans(coverage, rowX, rowY, stepX, stepY, boundsX, boundsY,
+                                                    constantMode, blockW);
+                    int64_t fx = rowX + spans.innerBegin * stepX;
+                    int64_t fy = rowY + spans.innerBegin * stepY;
+                    const int n = spans.innerEnd - spans.innerBegin;
+
+                    // Disposición planar: las mismas posiciones sirven para cada plano
+                    if (src.isPlanar()) {
+                        int64_t rowSrcX[BLOCK_SIZE];
+                        int64_t rowSrcY[BLOCK_SIZE];
+                        for (int x = 0; x < n; x++, fx += stepX, fy += stepY) {
+                            rowSrcX[x] = fx;
+                            rowSrcY[x] = fy;
+                        }
+                        for (int c = 0; c < src.channels; c++) {
+                            const ImageViewT<T> plane = src.plane(c);
+                            T *row = dst.plane(c).row(y) + blockX;
+                            fillPixels(row, spans.outerBegin, &constant[c], 1);
+                            bilinearBorderRow<1>(plane, rowX, rowY, stepX, stepY, spans.outerBegin, spans.innerBegin,
+                                                 integer, mode, &constant[c], row);
+                            bilinearPlaneRow(plane, rowSrcX, rowSrcY, n, integer, row + spans.innerBegin);
+                            bilinearBorderRow<1>(plane, rowX, rowY, stepX, stepY, spans.innerEnd, spans.outerEnd,
+                                                 integer, mode, &constant[c], row);
+                            fillPixels(row + spans.outerEnd, blockW - spans.outerEnd, &constant[c], 1);
+                        }
+                        continue;
+                    }
+
+                    // Las teselas miden al menos BLOCK_SIZE y los bloques están alineados
+                    // con ellas, así que cada fila del bloque es contigua en dst
+                    T *row = dst.pixelAt(blockX, y);
+                    T *out = row + spans.innerBegin * channels;
+                    fillPixels(row, spans.outerBegin, constant.data(), channels);
+
+                    // El kernel vectorial anula en registro las posiciones sin sus cuatro
+                    // vecinos: recorre el tramo exterior de una vez (partirlo añadiría
+                    // colas escalares) y el contorno se rehace después con el modo de borde
+                    const int outer = spans.outerEnd - spans.outerBegin;
+                    if (src.isTiled()) {
+                        for (int x = 0; x < n; x++, fx += stepX, fy += stepY, out += channels) {
+                            bilinearFixedPixel<C, true>(src, fx, fy, integer, out);
+                        }
+                    } else if (!simd || !simdRow(simd, src, rowX + spans.outerBegin * stepX,
+                                                 rowY + spans.outerBegin * stepY, stepX, stepY, outer,
+                                                 row + spans.outerBegin * channels)) {
+                        for (int x = 0; x < n; x++, fx += stepX, fy += stepY, out += channels) {
+                            bilinearFixedPixel<C, false>(src, fx, fy, integer, out);
+                        }
+                    }
+                    bilinearBorderRow<C>(src, rowX, rowY, stepX, stepY, spans.outerBegin, spans.innerBegin, integer,
+                                         mode, constant.data(), row);
+                    bilinearBorderRow<C>(src, rowX, rowY, stepX, stepY, spans.innerEnd, spans.outerEnd, integer,
+                                         mode, constant.data(), row);
+                    fillPixels(row + spans.outerEnd * channels, blockW - spans.outerEnd, constant.data(), channels);
+                }
+            }
+        }
+    }
+
+    // Núcleo de los filtros de remuestreo en la distancia x (en píxeles de src)
+    static double filterWeight(ResampleFilter filter, double x)
+    {
+        const double pi = 3.14159265358979323846;
+        x = std::fabs(x);
+
+        switch (filter) {
+            case ResampleFilter::Bicubic: {
+                const double a = -0.5;
+                if (x < 1.0) return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+                if (x < 2.0) return ((a * x - 5.0 * a) * x + 8.0 * a) * x - 4.0 * a;
+                return 0.0;
+            }
+            case ResampleFilter::Lanczos3:
+                if (x < 1e-9) return 1.0;
+                if (x < 3.0) return 3.0 * std::sin(pi * x) * std::sin(pi * x / 3.0) / (pi * pi * x * x);
+                return 0.0;
+            default:
+                return x < 1.0 ? 1.0 - x : 0.0;
+        }
+    }
+
+    // Radio del núcleo: vecinos a cada lado de la posición
+    static int filterRadius(ResampleFilter filter)
+    {
+        switch (filter) {
+            case ResampleFilter::Bicubic:  return 2;
+            case ResampleFilter::Lanczos3: return 3;
+            default:                       return 1;
+        }
+    }
+
+    // Pesos enteros de los filtros separables (bicúbico, Lanczos): BITS bits de
+    // fracción y acumuladores con signo por los lóbulos negativos. La suma de
+    // |pesos| llega a ~1.54 por eje (Lanczos-3), así que 255 * 1.54^2 * 2^20 cabe
+    // en 32 bits y en 16 bits la primera pasada (65535 * 1.54 * 2^14) también.
+    // BITS = 0: sin ruta entera (muestras float).
+    template <typename T>
+    struct FilterFixed
+    {
+        static const int BITS = 0;
+        typedef int32_t Accumulator;
+    };
+
+    template <>
+    struct FilterFixed<uint8_t>
+    {
+        static const int BITS = 10;
+        typedef int32_t Accumulator;
+    };
+
+    template <>
+    struct FilterFixed<uint16_t>
+    {
+        static const int BITS = 14;
+        typedef int64_t Accumulator;
+    };
+
+    // Aritmética de los filtros de dos pasadas: la primera deja Partial, la segunda
+    // suma en Accumulator desde start() y finish() da la muestra. Ruta en float;
+    // las muestras enteras se redondean al valor más cercano.
+    template <typename T, bool Integer>
+    struct FilterArithmetic
+    {
+        typedef float Weight;
+        typedef float Partial;
+        typedef float Accumulator;
+
+        static Weight weight(double value) { return static_cast<float>(value); }
+        static Accumulator start() { return std::numeric_limits<T>::is_integer ? 0.5f : 0.0f; }
+        static T finish(Accumulator value) { return SampleTraits<T>::fromFloat(value); }
+    };
+
+    // Ruta entera: pesos en coma fija con FilterFixed<T>::BITS bits, redondeo y
+    // saturación al final de la segunda pasada
+    template <typename T>
+    struct FilterArithmetic<T, true>
+    {
+        static const int BITS = FilterFixed<T>::BITS;
+        typedef int32_t Weight;
+        typedef int32_t Partial;
+        typedef typename FilterFixed<T>::Accumulator Accumulator;
+
+        static Weight weight(double value) { return static_cast<Weight>(std::floor(value * (1 << BITS) + 0.5)); }
+        static Accumulator start() { return (Accumulator(1) << (2 * BITS)) >> 1; }
+
+        static T finish(Accumulator value)
+        {
+            const Accumulator maximum = std::numeric_limits<T>::max();
+            return static_cast<T>(std::max(Accumulator(0), std::min(maximum, value >> (2 * BITS))));
+        }
+    };
+
+    // Normaliza los pesos de un tramo (suma 1) y los añade a weights. El error de
+    // redondeo se compensa en el peso mayor, así que una zona uniforme conserva
+    // su valor exacto también en la ruta entera.
+    template <typename Arithmetic>
+    static void storeWeights(const std::vector<double> &taps, std::vector<typename Arithmetic::Weight> &weights)
+    {
+        typedef typename Arithmetic::Weight Weight;
+
+        double total = 0.0;
+        for (double tap : taps) {
+            total += tap;
+        }
+
+        const size_t first = weights.size();
+        size_t largest = first;
+        Weight sum = 0;
+        for (size_t k = 0; k < taps.size(); k++) {
+            const Weight weight = Arithmetic::weight(taps[k] / total);
+            weights.push_back(weight);
+            sum += weight;
+            if (weight > weights[largest]) {
+                largest = first + k;
+            }
+        }
+        weights[largest] += Arithmetic::weight(1.0) - sum;
+    }
+
+    // Fases de las tablas de pesos de warpAffine: la fracción de la posición se
+    // redondea a 1/64 de píxel
+    const int FILTER_PHASE_BITS = 6;
+    const int FILTER_PHASES = 1 << FILTER_PHASE_BITS;
+
+    // Pesos de los TAPS vecinos para cada fase de 0 a FILTER_PHASES (la última es la
+    // fracción 1, así que el redondeo nunca cambia de vecino). El vecino k de la
+    // posición x está en floor(x) - TAPS / 2 + 1 + k.
+    template <int TAPS, typename Arithmetic>
+    static void buildPhaseTable(ResampleFilter filter, std::vector<typename Arithmetic::Weight> &table)
+    {
+        static thread_local std::vector<double> taps;
+        taps.resize(TAPS);
+        table.clear();
+
+        for (int phase = 0; phase <= FILTER_PHASES; phase++) {
+            const double fraction = (double)phase / FILTER_PHASES;
+            for (int k = 0; k < TAPS; k++) {
+                taps[k] = filterWeight(filter, k - TAPS / 2 + 1 - fraction);
+            }
+            storeWeights<Arithmetic>(taps, table);
+        }
+    }
+
+    // Muestra filtrada (TAPS x TAPS vecinos, primero en horizontal y después en
+    // vertical) de todos los canales en la posición (fx, fy) en coma fija. Sin
+    // Bordered el llamador garantiza que todos los vecinos están dentro de src; con
+    // él los de fuera se resuelven con el modo de borde (constant: el píxel del
+    // color de BorderMode::Constant).
+    template <int C, int TAPS, typename Arithmetic, bool Bordered, typename T>
+    static inline void filterPixel(const ImageViewT<T> &src, int64_t fx, int64_t fy,
+                                   const typename Arithmetic::Weight *table, BorderMode mode, const T *constant,
+                                   T *out)
+    {
+        typedef typename Arithmetic::Weight Weight;
+        typedef typename Arithmetic::Partial Partial;
+        typedef typename Arithmetic::Accumulator Accumulator;
+
+        const int channels = (C > 0) ? C : src.channels;
+        const int64_t x1 = fx >> FIXED_SHIFT;
+        const int64_t y1 = fy >> FIXED_SHIFT;
+
+        const int shift = FIXED_SHIFT - FILTER_PHASE_BITS;
+        const int64_t half = int64_t(1) << (shift - 1);
+        const Weight *wx = table + (((fx & (FIXED_ONE - 1)) + half) >> shift) * TAPS;
+        const Weight *wy = table + (((fy & (FIXED_ONE - 1)) + half) >> shift) * TAPS;
+
+        int columns[TAPS];
+        for (int k = 0; k < TAPS; k++) {
+            columns[k] = (int)x1 - TAPS / 2 + 1 + k;
+            if (Bordered) {
+                columns[k] = borderIndex(columns[k], src.width, mode);
+            }
+        }
+
+        // Sin teselas cada vecino es el inicio de su fila más el desplazamiento de
+        // su columna; en teselas se localiza uno a uno
+        const T *pixels[TAPS][TAPS];
+        for (int j = 0; j < TAPS; j++) {
+            int y = (int)y1 - TAPS / 2 + 1 + j;
+            if (Bordered) {
+                y = borderIndex(y, src.height, mode);
+                for (int k = 0; k < TAPS; k++) {
+                    pixels[j][k] = (y < 0 || columns[k] < 0) ? constant : src.pixelAt(columns[k], y);
+                }
+            } else if (src.isTiled()) {
+                for (int k = 0; k < TAPS; k++) {
+                    pixels[j][k] = src.tiledPixel(columns[k], y);
+                }
+            } else {
+                const T *row = src.row(y);
+                for (int k = 0; k < TAPS; k++) {
+                    pixels[j][k] = row + columns[k] * channels;
+                }
+            }
+        }
+
+        for (int c = 0; c < channels; c++) {
+            Accumulator sum = Arithmetic::start();
+            for (int j = 0; j < TAPS; j++) {
+                Partial partial = 0;
+                for (int k = 0; k < TAPS; k++) {
+                    partial += wx[k] * pixels[j][k][c];
+                }
+                sum += Accumulator(wy[j]) * partial;
+            }
+            out[c] = Arithmetic::finish(sum);
+        }
+    }
+
+    // filterPixel en las posiciones [begin, end) de una fila (fx + i * stepX,
+    // fy + i * stepY); out es el inicio de la fila
+    template <int C, int TAPS, typename Arithmetic, bool Bordered, typename T>
+    static inline void filterRow(const ImageViewT<T> &src, int64_t fx, int64_t fy, int64_t stepX, int64_t stepY,
+                                 int begin, int end, const typename Arithmetic::Weight *table, BorderMode mode,
+                                 const T *constant, T *out)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        fx += begin * stepX;
+        fy += begin * stepY;
+        out += (size_t)begin * channels;
+
+        for (int i = begin; i < end; i++, fx += stepX, fy += stepY, out += channels) {
+            filterPixel<C, TAPS, Arithmetic, Bordered>(src, fx, fy, table, mode, constant, out);
+        }
+    }
+
+    // Transformación afín con un filtro de TAPS x TAPS vecinos: mismo recorrido por
+    // bloques y en coma fija que affineKernel, con los pesos tomados de la tabla de
+    // fases en lugar de calcularse en cada píxel
+    template <int C, int TAPS, typename Arithmetic, typename T>
+    static void filterAffineKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst,
+                                   const AffineTransform &inverse, ResampleFilter filter)
+    {
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+        const float *m = inverse.m;
+        const int64_t stepX = toFixed(m[0]);
+        const int64_t stepY = toFixed(m[3]);
+
+        static thread_local std::vector<typename Arithmetic::Weight> phases;
+        const std::vector<typename Arithmetic::Weight> &table = phases;
+        buildPhaseTable<TAPS, Arithmetic>(filter, phases);
+
+        const int BLOCK_SIZE = 32;
+        const int gridOffset = dst.isTiled() ? (dst.originX & (BLOCK_SIZE - 1)) : 0;
+
+        // Bloques clasificados como en affineKernel, con el radio del filtro
+        const BorderMode mode = ImageBase::borderMode;
+        const bool constantMode = mode == BorderMode::Constant;
+        const std::vector<T> &constant = borderConstant<T>(src.channels);
+        const AxisBounds boundsX = axisBounds(src.width, TAPS / 2);
+        const AxisBounds boundsY = axisBounds(src.height, TAPS / 2);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(dynamic, 4) if(ImageBase::useParallelization)
+        #endif
+        for (int blockY = 0; blockY < dst.height; blockY += BLOCK_SIZE) {
+            for (int gridX = 0; gridX < dst.width + gridOffset; gridX += BLOCK_SIZE) {
+                int blockX = std::max(0, gridX - gridOffset);
+                int endY = std::min(blockY + BLOCK_SIZE, dst.height);
+                int endX = std::min(gridX - gridOffset + BLOCK_SIZE, dst.width);
+                int blockW = endX - blockX;
+
+                const BlockCoverage coverage = classifyBlock(m, blockX, blockY, blockW, endY - blockY, stepX, stepY,
+                                                             boundsX, boundsY, constantMode);
+
+                for (int y = blockY; y < endY; y++) {
+                    const int64_t rowX = toFixed((double)m[0] * blockX + (double)m[1] * y + m[2]);
+                    const int64_t rowY = toFixed((double)m[3] * blockX + (double)m[4] * y + m[5]);
+                    const RowSpans spans = rowSpans(coverage, rowX, rowY, stepX, stepY, boundsX, boundsY,
+                                                    constantMode, blockW);
+
+                    // Disposición planar: cada plano recorre las mismas posiciones
+                    for (int p = 0; p < planes; p++) {
+                        const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                        const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+                        const T *pixel = constant.data() + (src.isPlanar() ? p : 0);
+                        T *row = dstPlane.pixelAt(blockX, y);
+
+                        fillPixels(row, spans.outerBegin, pixel, channels);
+                        filterRow<C, TAPS, Arithmetic, true>(srcPlane, rowX, rowY, stepX, stepY, spans.outerBegin,
+                                                             spans.innerBegin, table.data(), mode, pixel, row);
+                        filterRow<C, TAPS, Arithmetic, false>(srcPlane, rowX, rowY, stepX, stepY, spans.innerBegin,
+                                                              spans.innerEnd, table.data(), mode, pixel, row);
+                        filterRow<C, TAPS, Arithmetic, true>(srcPlane, rowX, rowY, stepX, stepY, spans.innerEnd,
+                                                             spans.outerEnd, table.data(), mode, pixel, row);
+                        fillPixels(row + spans.outerEnd * channels, blockW - spans.outerEnd, pixel, channels);
+                    }
+                }
+            }
+        }
+    }
+
+    template <int C, int TAPS, typename T>
+    static void filterAffine(const ImageViewT<T> &src, const ImageViewT<T> &dst, const AffineTransform &inverse,
+                             ResampleFilter filter)
+    {
+        // Con muestras float ambas ramas usan la aritmética en float
+        if (ImageBase::useIntegerInterpolation) {
+            filterAffineKernel<C, TAPS, FilterArithmetic<T, (FilterFixed<T>::BITS > 0)> >(src, dst, inverse, filter);
+        } else {
+            filterAffineKernel<C, TAPS, FilterArithmetic<T, false> >(src, dst, inverse, filter);
+        }
+    }
+
+    // Posiciones en coma fija de un eje de src cuyo vecino más cercano
+    // ((f + 0.5) >> FIXED_SHIFT) cae dentro de la imagen. Sin vecinos que mezclar
+    // no hay contorno: los límites interior y exterior coinciden.
+    static inline AxisBounds nearestBounds(int size)
+    {
+        AxisBounds bounds;
+        bounds.innerLo = bounds.outerLo = -FIXED_ONE / 2;
+        bounds.innerHi = bounds.outerHi = (int64_t)size * FIXED_ONE - FIXED_ONE / 2;
+        return bounds;
+    }
+
+    // Vecino más cercano para las posiciones [begin, end) de una fila (fx + i *
+    // stepX, fy + i * stepY): un índice y una copia de muestras por píxel. Con
+    // Bordered los índices fuera de src pasan por el modo de borde; sin él todos
+    // caen dentro y se leen directamente (Tiled: src en teselas).
+    template <int C, bool Bordered, bool Tiled, typename T>
+    static void nearestRow(const ImageViewT<T> &src, int64_t fx, int64_t fy, int64_t stepX, int64_t stepY,
+                           int begin, int end, BorderMode mode, const T *constant, T *out)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        fx += begin * stepX + FIXED_ONE / 2;
+        fy += begin * stepY + FIXED_ONE / 2;
+        out += (size_t)begin * channels;
+
+        // Las escrituras en dst (char en 8 bits) podrían solaparse con la vista para
+        // el compilador: puntero y stride se leen una vez
+        const T *data = src.data;
+        const size_t stride = src.stride;
+
+        for (int i = begin; i < end; i++, fx += stepX, fy += stepY, out += channels) {
+            const int x = (int)(fx >> FIXED_SHIFT);
+            const int y = (int)(fy >> FIXED_SHIFT);
+            const T *in;
+            if (Bordered) {
+                in = borderPixel(src, x, y, mode, constant);
+            } else if (Tiled) {
+                in = src.tiledPixel(x, y);
+            } else {
+                in = data + (size_t)y * stride + (size_t)x * channels;
+            }
+            for (int c = 0; c < channels; c++) {
+                out[c] = in[c];
+            }
+        }
+    }
+
+    // Transformación afín con el vecino más cercano: mismo recorrido por bloques y
+    // en coma fija que affineKernel, pero cada píxel de dst copia uno de src, sin
+    // pesos ni aritmética por canal
+    template <int C, typename T>
+    static void nearestAffineKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, const AffineTransform &inverse)
+    {
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+        const float *m = inverse.m;
+        const int64_t stepX = toFixed(m[0]);
+        const int64_t stepY = toFixed(m[3]);
+
+        const int BLOCK_SIZE = 32;
+        const int gridOffset = dst.isTiled() ? (dst.originX & (BLOCK_SIZE - 1)) : 0;
+
+        const BorderMode mode = ImageBase::borderMode;
+        const bool constantMode = mode == BorderMode::Constant;
+        const std::vector<T> &constant = borderConstant<T>(src.channels);
+        const AxisBounds boundsX = nearestBounds(src.width);
+        const AxisBounds boundsY = nearestBounds(src.height);
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(dynamic, 4) if(ImageBase::useParallelization)
+        #endif
+        for (int blockY = 0; blockY < dst.height; blockY += BLOCK_SIZE) {
+            for (int gridX = 0; gridX < dst.width + gridOffset; gridX += BLOCK_SIZE) {
+                int blockX = std::max(0, gridX - gridOffset);
+                int endY = std::min(blockY + BLOCK_SIZE, dst.height);
+                int endX = std::min(gridX - gridOffset + BLOCK_SIZE, dst.width);
+                int blockW = endX - blockX;
+
+                const BlockCoverage coverage = classifyBlock(m, blockX, blockY, blockW, endY - blockY, stepX, stepY,
+                                                             boundsX, boundsY, constantMode);
+
+                for (int y = blockY; y < endY; y++) {
+                    const int64_t rowX = toFixed((double)m[0] * blockX + (double)m[1] * y + m[2]);
+                    const int64_t rowY = toFixed((double)m[3] * blockX + (double)m[4] * y + m[5]);
+                    const RowSpans spans = rowSpans(coverage, rowX, rowY, stepX, stepY, boundsX, boundsY,
+                                                    constantMode, blockW);
+
+                    for (int p = 0; p < planes; p++) {
+                        const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                        const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+                        const T *pixel = constant.data() + (src.isPlanar() ? p : 0);
+                        T *row = dstPlane.pixelAt(blockX, y);
+
+                        fillPixels(row, spans.outerBegin, pixel, channels);
+                        nearestRow<C, true, false>(srcPlane, rowX, rowY, stepX, stepY, spans.outerBegin,
+                                                   spans.innerBegin, mode, pixel, row);
+                        if (srcPlane.isTiled()) {
+                            nearestRow<C, false, true>(srcPlane, rowX, rowY, stepX, stepY, spans.innerBegin,
+                                                       spans.innerEnd, mode, pixel, row);
+                        } else {
+                            nearestRow<C, false, false>(srcPlane, rowX, rowY, stepX, stepY, spans.innerBegin,
+                                                        spans.innerEnd, mode, pixel, row);
+                        }
+                        nearestRow<C, true, false>(srcPlane, rowX, rowY, stepX, stepY, spans.innerEnd,
+                                                   spans.outerEnd, mode, pixel, row);
+                        fillPixels(row + spans.outerEnd * channels, blockW - spans.outerEnd, pixel, channels);
+                    }
+                }
+            }
+        }
+    }
+
+    template <int C, typename T>
+    static void warpChannels(const ImageViewT<T> &src, const ImageViewT<T> &dst, const AffineTransform &inverse,
+                             ResampleFilter filter)
+    {
+        switch (filter) {
+            case ResampleFilter::Nearest:
+                nearestAffineKernel<C>(src, dst, inverse);
+                break;
+            case ResampleFilter::Bicubic:
+                filterAffine<C, 4>(src, dst, inverse, ResampleFilter::Bicubic);
+                break;
+            case ResampleFilter::Lanczos3:
+                filterAffine<C, 6>(src, dst, inverse, ResampleFilter::Lanczos3);
+                break;
+            default:
+                affineKernel<C>(src, dst, inverse);
+                break;
+        }
+    }
+
+    // Los kernels se eligen una vez por llamada según el número de canales; la
+    // disposición planar trabaja plano a plano y no depende de él
+    template <typename T>
+    void warpAffine(const ImageViewT<T> &src, const ImageViewT<T> &dst, const AffineTransform &transform,
+                    ResampleFilter filter)
+    {
+        AffineTransform inverse = transform.inverse();
+
+        switch (src.isPlanar() ? 0 : src.channels) {
+            case 1:  warpChannels<1>(src, dst, inverse, filter); break;
+            case 2:  warpChannels<2>(src, dst, inverse, filter); break;
+            case 3:  warpChannels<3>(src, dst, inverse, filter); break;
+            case 4:  warpChannels<4>(src, dst, inverse, filter); break;
+            default: warpChannels<0>(src, dst, inverse, filter); break;
+        }
+    }
+
+    // Aritmética de las dos pasadas de resize. Ruta en float: cada pasada es una
+    // interpolación lineal entre dos vecinos.
+    template <typename T, bool Integer>
+    struct ResizeArithmetic
+    {
+        typedef float Weight;
+        typedef float Partial;
+
+        static Weight one() { return 1.0f; }
+        static Weight weight(uint32_t fraction) { return fraction * FIXED_SCALE; }
+
+        static Partial horizontal(T first, T second, Weight w0, Weight w1) { return w0 * first + w1 * second; }
+
+        static T vertical(Partial top, Partial bottom, Weight w0, Weight w1)
+        {
+            return SampleTraits<T>::fromFloat(w0 * top + w1 * bottom);
+        }
+    };
+
+    // Ruta entera: los mismos pesos y el mismo redondeo que bilinearTapsInteger, así
+    // que el resultado coincide con la interpolación bilineal de un solo paso
+    template <typename T>
+    struct ResizeArithmetic<T, true>
+    {
+        typedef uint32_t Weight;
+        typedef typename FixedWeights<T>::Partial Partial;
+        typedef typename FixedWeights<T>::Accumulator Accumulator;
+        static const int BITS = FixedWeights<T>::BITS;
+
+        static Weight one() { return Weight(1) << BITS; }
+
+        static Weight weight(uint32_t fraction)
+        {
+            const int drop = FIXED_SHIFT - BITS;
+            return (fraction + ((1u << drop) >> 1)) >> drop;
+        }
+
+        static Partial horizontal(T first, T second, Weight w0, Weight w1)
+        {
+            return static_cast<Partial>(first * Accumulator(w0) + second * Accumulator(w1));
+        }
+
+        static T vertical(Partial top, Partial bottom, Weight w0, Weight w1)
+        {
+            return static_cast<T>((top * Accumulator(w0) + bottom * Accumulator(w1)) >> (2 * BITS));
+        }
+    };
+
+    // Entrada de la tabla de un eje: primer vecino en src y pesos de los dos
+    template <typename W>
+    struct ResizeTap
+    {
+        int index;
+        W first;
+        W second;
+    };
+
+    // Tabla de un eje: una entrada por columna (o fila) de dst. Al ampliar, las
+    // últimas posiciones caen pasado el último píxel de src, que no tiene vecino
+    // siguiente: repiten el borde (pesos 0 y 1 sobre el penúltimo y el último). Sin
+    // dos píxeles en src quedan en negro: en columnas, pesos 0 sobre el índice 0;
+    // en filas, índice -1.
+    template <typename Arithmetic>
+    static void buildResizeTable(int dstSize, int srcSize, float factor, int outsideIndex,
+                                 std::vector<ResizeTap<typename Arithmetic::Weight> > &table)
+    {
+        table.resize(dstSize);
+
+        for (int i = 0; i < dstSize; i++) {
+            const int64_t position = toFixed((double)i / factor);
+            const int64_t first = position >> FIXED_SHIFT;
+            ResizeTap<typename Arithmetic::Weight> &tap = table[i];
+
+            if (position < 0 || srcSize < 2) {
+                tap.index = outsideIndex;
+                tap.first = tap.second = 0;
+            } else if (first >= srcSize - 1) {
+                tap.index = srcSize - 2;
+                tap.first = 0;
+                tap.second = Arithmetic::one();
+            } else {
+                tap.index = (int)first;
+                tap.second = Arithmetic::weight((uint32_t)(position & (FIXED_ONE - 1)));
+                tap.first = Arithmetic::one() - tap.second;
+            }
+        }
+    }
+
+    // Pasada horizontal de la fila y de src a los parciales de las columnas de dst
+    template <int C, typename Arithmetic, typename T>
+    static void resizeRowHorizontal(const ImageViewT<T> &src, int y,
+                                    const std::vector<ResizeTap<typename Arithmetic::Weight> > &columns,
+                                    typename Arithmetic::Partial *out)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        const int width = (int)columns.size();
+
+        if (src.isTiled()) {
+            for (int x = 0; x < width; x++, out += channels) {
+                const T *first  = src.tiledPixel(columns[x].index, y);
+                const T *second = src.tiledPixel(columns[x].index + 1, y);
+                for (int c = 0; c < channels; c++) {
+                    out[c] = Arithmetic::horizontal(first[c], second[c], columns[x].first, columns[x].second);
+                }
+            }
+            return;
+        }
+
+        const T *row = src.row(y);
+        for (int x = 0; x < width; x++, out += channels) {
+            const T *first = row + columns[x].index * channels;
+            for (int c = 0; c < channels; c++) {
+                out[c] = Arithmetic::horizontal(first[c], first[channels + c], columns[x].first, columns[x].second);
+            }
+        }
+    }
+
+    // Redimensionado separable: cada fila de src se filtra en horizontal una sola
+    // vez hacia un buffer intermedio y cada fila de dst combina dos de ellas en
+    // vertical. Índices y pesos salen de tablas por columna y por fila calculadas
+    // al principio, así que los bucles internos sólo leen, multiplican y suman.
+    template <int C, typename T, bool Integer>
+    static void resizeKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY)
+    {
+        typedef ResizeArithmetic<T, Integer> Arithmetic;
+        typedef typename Arithmetic::Weight Weight;
+        typedef typename Arithmetic::Partial Partial;
+
+        // Disposición planar: cada plano se redimensiona como una imagen de un canal
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+        const size_t rowLength = (size_t)dst.width * channels;
+
+        // Sin dos vecinos en algún eje toda la imagen queda en negro (las columnas
+        // fuera de src leen el índice 0 y su vecino)
+        const bool empty = src.width < 2 || src.height < 2;
+
+        static thread_local std::vector<ResizeTap<Weight> > columnTable, rowTable;
+        const std::vector<ResizeTap<Weight> > &columns = columnTable, &rows = rowTable;
+        buildResizeTable<Arithmetic>(dst.width, src.width, factorX, 0, columnTable);
+        buildResizeTable<Arithmetic>(dst.height, empty ? 0 : src.height, factorY, -1, rowTable);
+
+        // Bandas de filas de dst; cada hilo guarda las dos últimas filas filtradas
+        const int BAND_HEIGHT = 32;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(dynamic) if(ImageBase::useParallelization)
+        #endif
+        for (int p = 0; p < planes; p++) {
+            for (int bandY = 0; bandY < dst.height; bandY += BAND_HEIGHT) {
+                const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+                const int endY = std::min(bandY + BAND_HEIGHT, dst.height);
+
+                // Filas de src ya filtradas: al ampliar, varias filas de dst seguidas
+                // usan las mismas dos
+                static thread_local std::vector<Partial> partials;
+                partials.resize(2 * rowLength);
+                Partial *top = partials.data();
+                Partial *bottom = top + rowLength;
+                int topRow = -1, bottomRow = -1;
+
+                for (int y = bandY; y < endY; y++) {
+                    const ResizeTap<Weight> &tap = rows[y];
+
+                    if (tap.index < 0) {
+                        for (int x = 0; x < dst.width; ) {
+                            const int run = runLength(dstPlane, x);
+                            T *out = dstPlane.pixelAt(x, y);
+                            std::fill(out, out + run * channels, T(0));
+                            x += run;
+                        }
+                        continue;
+                    }
+
+                    if (topRow != tap.index) {
+                        if (bottomRow == tap.index) {
+                            std::swap(top, bottom);
+                            std::swap(topRow, bottomRow);
+                        } else {
+                            resizeRowHorizontal<C, Arithmetic>(srcPlane, tap.index, columns, top);
+                            topRow = tap.index;
+                        }
+                    }
+                    if (bottomRow != tap.index + 1) {
+                        resizeRowHorizontal<C, Arithmetic>(srcPlane, tap.index + 1, columns, bottom);
+                        bottomRow = tap.index + 1;
+                    }
+
+                    // Pasada vertical sobre tramos contiguos de la fila de dst
+                    for (int x = 0; x < dst.width; ) {
+                        const int run = runLength(dstPlane, x);
+                        const Partial *t = top + (size_t)x * channels;
+                        const Partial *b = bottom + (size_t)x * channels;
+                        T *out = dstPlane.pixelAt(x, y);
+                        for (int i = 0; i < run * channels; i++) {
+                            out[i] = Arithmetic::vertical(t[i], b[i], tap.first, tap.second);
+                        }
+                        x += run;
+                    }
+                }
+            }
+        }
+    }
+
+    // Tramo de src que contribuye a una columna (o fila) de dst en spanKernel:
+    // primer píxel, número de píxeles y posición de sus pesos en la tabla
+    struct ResampleSpan
+    {
+        int start;
+        int count;
+        size_t offset;
+    };
+
+    // Tabla de un eje para el promedio de área. Al reducir (factor < 1) cada píxel
+    // de dst promedia el intervalo [i / factor, (i + 1) / factor) de src, con cada
+    // píxel pesado por la parte que cubre; al ampliar se usan los dos vecinos de la
+    // interpolación lineal, y pasado el último píxel de src se repite el borde
+    // (como buildResizeTable). Sin píxeles de src el tramo queda vacío (negro).
+    static void buildSpanTable(int dstSize, int srcSize, float factor, std::vector<ResampleSpan> &spans,
+                               std::vector<float> &weights)
+    {
+        spans.resize(dstSize);
+        weights.clear();
+
+        for (int i = 0; i < dstSize; i++) {
+            ResampleSpan &span = spans[i];
+            span.offset = weights.size();
+            span.start = 0;
+            span.count = 0;
+
+            if (factor >= 1.0f) {
+                const int64_t position = toFixed((double)i / factor);
+                const int64_t first = position >> FIXED_SHIFT;
+                if (srcSize > 0 && first >= srcSize - 1) {
+                    span.start = srcSize - 1;
+                    span.count = 1;
+                    weights.push_back(1.0f);
+                } else if (position >= 0) {
+                    const float fraction = (position & (FIXED_ONE - 1)) * FIXED_SCALE;
+                    span.start = (int)first;
+                    span.count = 2;
+                    weights.push_back(1.0f - fraction);
+                    weights.push_back(fraction);
+                }
+                continue;
+            }
+
+            const double begin = std::max(0.0, (double)i / factor);
+            const double end = std::min((double)srcSize, (double)(i + 1) / factor);
+            if (end <= begin) {
+                continue;
+            }
+
+            span.start = (int)std::floor(begin);
+            span.count = (int)std::ceil(end) - span.start;
+            for (int k = 0; k < span.count; k++) {
+                const double covered = std::min(end, (double)(span.start + k + 1)) - std::max(begin, (double)(span.start + k));
+                weights.push_back((float)(covered / (end - begin)));
+            }
+        }
+    }
+
+    // Tabla de un eje para los filtros bicúbico y Lanczos. Al ampliar el píxel i de
+    // dst se centra en i / factor, como la interpolación bilineal, y pasado el
+    // último píxel de src repite el borde (como buildResizeTable); al reducir se
+    // centra en el intervalo que cubre, como el promedio de área, y el núcleo se
+    // ensancha en 1 / factor para no producir aliasing. Los vecinos fuera de src
+    // repiten el borde: su peso se suma al del píxel del borde, también en la
+    // última fila y columna.
+    template <typename Arithmetic>
+    static void buildFilterTable(int dstSize, int srcSize, float factor, ResampleFilter filter,
+                                 std::vector<ResampleSpan> &spans, std::vector<typename Arithmetic::Weight> &weights)
+    {
+        const double scale = std::min(1.0, (double)factor);
+        const double support = filterRadius(filter) / scale;
+        static thread_local std::vector<double> taps;
+
+        spans.resize(dstSize);
+        weights.clear();
+
+        for (int i = 0; i < dstSize; i++) {
+            ResampleSpan &span = spans[i];
+            span.offset = weights.size();
+            span.start = 0;
+            span.count = 0;
+
+            double center;
+            if (factor >= 1.0f) {
+                const int64_t position = toFixed((double)i / factor);
+                center = std::min(position * (double)FIXED_SCALE, (double)(srcSize - 1));
+            } else {
+                center = (i + 0.5) / factor - 0.5;
+            }
+
+            const int first = (int)std::floor(center - support) + 1;
+            const int last = (int)std::ceil(center + support) - 1;
+            span.start = std::max(first, 0);
+            span.count = std::min(last, srcSize - 1) - span.start + 1;
+            if (span.count <= 0) {
+                span.count = 0;
+                continue;
+            }
+
+            taps.assign(span.count, 0.0);
+            for (int j = first; j <= last; j++) {
+                const int index = std::min(std::max(j, 0), srcSize - 1);
+                taps[index - span.start] += filterWeight(filter, (j - center) * scale);
+            }
+            storeWeights<Arithmetic>(taps, weights);
+        }
+    }
+
+    // Pasada vertical de spanKernel: suma la fila y de src, con peso weight, a sum
+    // (toda la fila; contigua, así que el bucle se vectoriza)
+    template <typename Arithmetic, typename T>
+    static void spanAccumulateRow(const ImageViewT<T> &src, int y, int channels, typename Arithmetic::Weight weight,
+                                  typename Arithmetic::Partial *sum)
+    {
+        for (int x = 0; x < src.width; ) {
+            const int run = runLength(src, x);
+            const T *in = src.pixelAt(x, y);
+            typename Arithmetic::Partial *out = sum + (size_t)x * channels;
+            for (int i = 0; i < run * channels; i++) {
+                out[i] += weight * in[i];
+            }
+            x += run;
+        }
+    }
+
+    // Remuestreo separable con tramos de longitud variable por columna y por fila
+    // (promedio de área y filtros bicúbico y Lanczos). A diferencia de resizeKernel
+    // la pasada vertical va primero: las filas de src que usa una fila de dst se
+    // suman enteras (bucle contiguo) y la pasada horizontal sólo recorre esa suma.
+    template <int C, typename Arithmetic, typename T>
+    static void spanKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst,
+                           const std::vector<ResampleSpan> &columns,
+                           const std::vector<typename Arithmetic::Weight> &columnWeights,
+                           const std::vector<ResampleSpan> &rows,
+                           const std::vector<typename Arithmetic::Weight> &rowWeights)
+    {
+        typedef typename Arithmetic::Weight Weight;
+        typedef typename Arithmetic::Partial Partial;
+        typedef typename Arithmetic::Accumulator Accumulator;
+
+        // Disposición planar: cada plano se remuestrea como una imagen de un canal
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+
+        const int BAND_HEIGHT = 32;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(dynamic) if(ImageBase::useParallelization)
+        #endif
+        for (int p = 0; p < planes; p++) {
+            for (int bandY = 0; bandY < dst.height; bandY += BAND_HEIGHT) {
+                const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+                const int endY = std::min(bandY + BAND_HEIGHT, dst.height);
+
+                static thread_local std::vector<Partial> sum;
+                sum.resize((size_t)src.width * channels);
+
+                for (int y = bandY; y < endY; y++) {
+                    const ResampleSpan &rowSpan = rows[y];
+                    std::fill(sum.begin(), sum.end(), Partial(0));
+                    for (int k = 0; k < rowSpan.count; k++) {
+                        spanAccumulateRow<Arithmetic>(srcPlane, rowSpan.start + k, channels,
+                                                      rowWeights[rowSpan.offset + k], sum.data());
+                    }
+
+                    // Las escrituras en dst (char en 8 bits) pueden solaparse con cualquier
+                    // cosa para el compilador: tablas y suma se leen desde punteros locales
+                    const ResampleSpan *spans = columns.data();
+                    const Weight *weights = columnWeights.data();
+                    const Partial *rowSum = sum.data();
+
+                    for (int x = 0; x < dst.width; ) {
+                        const int run = runLength(dstPlane, x);
+                        T *out = dstPlane.pixelAt(x, y);
+                        for (int i = x; i < x + run; i++, out += channels) {
+                            const int start = spans[i].start, count = spans[i].count;
+                            const Weight *w = weights + spans[i].offset;
+                            const Partial *in = rowSum + (size_t)start * channels;
+                            if (C > 0) {
+                                // Con los canales por fuera de los tramos cada suma sería
+                                // una cadena de dependencias; así los C acumuladores avanzan
+                                // a la vez
+                                Accumulator value[C > 0 ? C : 1];
+                                for (int c = 0; c < C; c++) value[c] = Arithmetic::start();
+                                for (int k = 0; k < count; k++, in += C) {
+                                    for (int c = 0; c < C; c++) value[c] += Accumulator(w[k]) * in[c];
+                                }
+                                for (int c = 0; c < C; c++) out[c] = Arithmetic::finish(value[c]);
+                            } else {
+                                for (int c = 0; c < channels; c++) {
+                                    Accumulator value = Arithmetic::start();
+                                    for (int k = 0; k < count; k++) {
+                                        value += Accumulator(w[k]) * in[k * channels + c];
+                                    }
+                                    out[c] = Arithmetic::finish(value);
+                                }
+                            }
+                        }
+                        x += run;
+                    }
+                }
+            }
+        }
+    }
+
+    // Reducción por promedio de área (filtro de caja): cada píxel de src cuenta una
+    // vez, así que una reducción fuerte no pierde información ni produce aliasing
+    // como el muestreo de cuatro vecinos
+    template <int C, typename T>
+    static void areaKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY)
+    {
+        static thread_local std::vector<ResampleSpan> columns, rows;
+        static thread_local std::vector<float> columnWeights, rowWeights;
+        buildSpanTable(dst.width, src.width, factorX, columns, columnWeights);
+        buildSpanTable(dst.height, src.height, factorY, rows, rowWeights);
+
+        spanKernel<C, FilterArithmetic<T, false> >(src, dst, columns, columnWeights, rows, rowWeights);
+    }
+
+    // Redimensionado con los filtros bicúbico o Lanczos: tablas de pesos por
+    // columna y por fila calculadas una vez (un juego por cada fase distinta)
+    template <int C, typename Arithmetic, typename T>
+    static void filterResizeKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY,
+                                   ResampleFilter filter)
+    {
+        static thread_local std::vector<ResampleSpan> columns, rows;
+        static thread_local std::vector<typename Arithmetic::Weight> columnWeights, rowWeights;
+        buildFilterTable<Arithmetic>(dst.width, src.width, factorX, filter, columns, columnWeights);
+        buildFilterTable<Arithmetic>(dst.height, src.height, factorY, filter, rows, rowWeights);
+
+        spanKernel<C, Arithmetic>(src, dst, columns, columnWeights, rows, rowWeights);
+    }
+
+    // Tabla de un eje para el vecino más cercano: el píxel i de dst copia el de src
+    // que contiene (i + 0.5) / factor (con factor entero, i / factor exacto)
+    static void buildNearestTable(int dstSize, int srcSize, float factor, std::vector<int> &indices)
+    {
+        indices.resize(dstSize);
+        for (int i = 0; i < dstSize; i++) {
+            const double position = std::floor((i + 0.5) / factor);
+            indices[i] = (int)std::min(std::max(position, 0.0), (double)(srcSize - 1));
+        }
+    }
+
+    // Ampliación entera de 2, 3 o 4 en un eje (dst mide exactamente factor * src):
+    // cada píxel se repite sin tabla; 0 si no es el caso
+    static int replicationFactor(int dstSize, int srcSize, float factor)
+    {
+        for (int k = 2; k <= 4; k++) {
+            if (factor == (float)k && dstSize == k * srcSize) {
+                return k;
+            }
+        }
+        return 0;
+    }
+
+    // Fila de dst que repite K veces cada uno de los n píxeles de in
+    template <int K, int C, typename T>
+    static void replicateRow(const T *in, int n, T *out)
+    {
+        for (int x = 0; x < n; x++, in += C) {
+            for (int k = 0; k < K; k++, out += C) {
+                for (int c = 0; c < C; c++) {
+                    out[c] = in[c];
+                }
+            }
+        }
+    }
+
+    // Redimensionado con el vecino más cercano: cada fila de dst es una
+    // recolección de píxeles de una fila de src por la tabla de columnas, o una
+    // copia de la fila anterior de dst si ambas salen de la misma fila de src
+    // (ampliación en vertical). Las ampliaciones enteras de 2, 3 y 4 en
+    // horizontal repiten cada píxel sin pasar por la tabla.
+    template <int C, typename T>
+    static void nearestResizeKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY)
+    {
+        const int channels = (C > 0) ? C : src.channels;
+        const bool empty = src.width < 1 || src.height < 1;
+
+        static thread_local std::vector<int> columnTable, rowTable;
+        static thread_local std::vector<size_t> offsetTable;
+        const std::vector<int> &columns = columnTable, &rows = rowTable;
+        const std::vector<size_t> &offsets = offsetTable;
+        buildNearestTable(dst.width, src.width, factorX, columnTable);
+        buildNearestTable(dst.height, src.height, factorY, rowTable);
+
+        // Desplazamiento de cada columna dentro de la fila de src (sin teselas)
+        offsetTable.resize(dst.width);
+        for (int x = 0; x < dst.width; x++) {
+            offsetTable[x] = (size_t)columns[x] * channels;
+        }
+
+        // La repetición escribe filas enteras: sólo sin teselas y con C fijo
+        const int replicate = (C > 0 && !src.isTiled() && !dst.isTiled())
+                            ? replicationFactor(dst.width, src.width, factorX) : 0;
+
+        const int BAND_HEIGHT = 32;
+
         #if defined(_OPENMP)
-        if (useParallelization) {
-            #pragma omp parallel for collapse(2) schedule(dynamic, 4) private(srcX, srcY, outBuffer)
-            for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
-                for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
-                    // Crear buffers locales para cada hilo
-                    float localSrcX[BLOCK_SIZE * BLOCK_SIZE];
-                    float localSrcY[BLOCK_SIZE * BLOCK_SIZE];
-                    // Eliminada la variable no utilizada localOutBuffer
-                    
-                    // Definir los límites del bloque
-                    int endY = std::min(blockY + BLOCK_SIZE, height);
-                    int endX = std::min(blockX + BLOCK_SIZE, width);
-                    int blockH = endY - blockY;
-                    int blockW = endX - blockX;
-                    
-                    // Pre-calcular coordenadas de origen para todo el bloque
-                    for (int y = 0; y < blockH; y++) {
-                        for (int x = 0; x < blockW; x++) {
-                            // Coordenadas en la imagen de destino
-                            int destX = blockX + x;
-                            int destY = blockY + y;
-                            
-                            // Trasladar al origen (centro de la imagen)
-                            float xOffset = destX - centerX;
-                            float yOffset = destY - centerY;
-                            
-                            // Aplicar la rotación inversa
-                            localSrcX[y * blockW + x] = xOffset * cosAngle + yOffset * sinAngle + centerX;
-                            localSrcY[y * blockW + x] = -xOffset * sinAngle + yOffset * cosAngle + centerY;
+        #pragma omp parallel for schedule(dynamic) if(ImageBase::useParallelization)
+        #endif
+        for (int bandY = 0; bandY < dst.height; bandY += BAND_HEIGHT) {
+            const int endY = std::min(bandY + BAND_HEIGHT, dst.height);
+
+            for (int y = bandY; y < endY; y++) {
+                const int sourceY = rows[y];
+                for (int x = 0; x < dst.width; ) {
+                    const int run = runLength(dst, x);
+                    T *out = dst.pixelAt(x, y);
+
+                    if (empty) {
+                        std::fill(out, out + run * channels, T(0));
+                    } else if (y > bandY && rows[y - 1] == sourceY) {
+                        const T *previous = dst.pixelAt(x, y - 1);
+                        std::copy(previous, previous + run * channels, out);
+                    } else if (replicate > 0) {
+                        const T *in = src.row(sourceY);
+                        switch (replicate) {
+                            case 2:  replicateRow<2, C>(in, src.width, out); break;
+                            case 3:  replicateRow<3, C>(in, src.width, out); break;
+                            default: replicateRow<4, C>(in, src.width, out); break;
                         }
-                    }
-                    
-                    // Procesar el bloque completo para todos los canales
-                    for (int y = 0; y < blockH; y++) {
-                        for (int x = 0; x < blockW; x++) {
-                            float xPos = localSrcX[y * blockW + x];
-                            float yPos = localSrcY[y * blockW + x];
-                            
-                            if (xPos < 0 || yPos < 0 || xPos >= width - 1 || yPos >= height - 1) {
-                                for (int c = 0; c < channels; c++) {
-                                    rotatedImage.pixels[blockY + y][blockX + x][c] = 0;
-                                }
-                                continue;
+                    } else if (src.isTiled()) {
+                        for (int i = x; i < x + run; i++, out += channels) {
+                            const T *in = src.tiledPixel(columns[i], sourceY);
+                            for (int c = 0; c < channels; c++) {
+                                out[c] = in[c];
                             }
-                            
-                            int x1 = static_cast<int>(xPos);
-                            int y1 = static_cast<int>(yPos);
-                            int x2 = x1 + 1;
-                            int y2 = y1 + 1;
-                            
-                            float dx = xPos - x1;
-                            float dy = yPos - y1;
-                            float w1 = (1.0f - dx) * (1.0f - dy);
-                            float w2 = dx * (1.0f - dy);
-                            float w3 = (1.0f - dx) * dy;
-                            float w4 = dx * dy;
-                            
+                        }
+                    } else {
+                        const T *in = src.row(sourceY);
+                        const size_t *offset = offsets.data();
+                        for (int i = x; i < x + run; i++, out += channels) {
                             for (int c = 0; c < channels; c++) {
-                                unsigned char p1 = pixels[y1][x1][c];
-                                unsigned char p2 = pixels[y1][x2][c];
-                                unsigned char p3 = pixels[y2][x1][c];
-                                unsigned char p4 = pixels[y2][x2][c];
-                                
-                                float value = w1 * p1 + w2 * p2 + w3 * p3 + w4 * p4;
-                                rotatedImage.pixels[blockY + y][blockX + x][c] = 
-                                    static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, value)));
+                                out[c] = in[offset[i] + c];
                             }
                         }
                     }
+                    x += run;
                 }
             }
-        } else 
+        }
+    }
+
+    // Disposición planar: cada plano se redimensiona como una imagen de un canal,
+    // así que también tiene las rutas de C fijo
+    template <int C, typename T>
+    static void nearestResize(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY)
+    {
+        if (src.isPlanar()) {
+            for (int p = 0; p < src.channels; p++) {
+                nearestResizeKernel<1>(src.plane(p), dst.plane(p), factorX, factorY);
+            }
+            return;
+        }
+        nearestResizeKernel<C>(src, dst, factorX, factorY);
+    }
+
+    template <int C, typename T>
+    static void resizeChannels(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY,
+                               ResampleFilter filter)
+    {
+        if (filter == ResampleFilter::Nearest) {
+            nearestResize<C>(src, dst, factorX, factorY);
+            return;
+        }
+
+        if (filter == ResampleFilter::Bicubic || filter == ResampleFilter::Lanczos3) {
+            // Con muestras float ambas ramas usan la aritmética en float
+            if (ImageBase::useIntegerInterpolation) {
+                filterResizeKernel<C, FilterArithmetic<T, (FilterFixed<T>::BITS > 0)> >(src, dst, factorX, factorY, filter);
+            } else {
+                filterResizeKernel<C, FilterArithmetic<T, false> >(src, dst, factorX, factorY, filter);
+            }
+            return;
+        }
+
+        // Reducción en algún eje: promedio de área
+        if (factorX < 1.0f || factorY < 1.0f) {
+            areaKernel<C>(src, dst, factorX, factorY);
+            return;
+        }
+
+        // Pesos enteros con muestras de 8 y 16 bits (ver bilinearTapsInteger)
+        if (FixedWeights<T>::BITS > 0 && ImageBase::useIntegerInterpolation) {
+            resizeKernel<C, T, true>(src, dst, factorX, factorY);
+        } else {
+            resizeKernel<C, T, false>(src, dst, factorX, factorY);
+        }
+    }
+
+    template <typename T>
+    void resize(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY,
+                ResampleFilter filter)
+    {
+        switch (src.isPlanar() ? 0 : src.channels) {
+            case 1:  resizeChannels<1>(src, dst, factorX, factorY, filter); break;
+            case 2:  resizeChannels<2>(src, dst, factorX, factorY, filter); break;
+            case 3:  resizeChannels<3>(src, dst, factorX, factorY, filter); break;
+            case 4:  resizeChannels<4>(src, dst, factorX, factorY, filter); break;
+            default: resizeChannels<0>(src, dst, factorX, factorY, filter); break;
+        }
+    }
+
+    // Aritmética de halve: suma de las dos filas sin desbordar y promedio final de
+    // las dos sumas, redondeado al entero más cercano
+    template <typename T>
+    struct HalveArithmetic
+    {
+        typedef typename FixedWeights<T>::Partial Sum;
+        static T average(Sum first, Sum second) { return static_cast<T>((uint32_t(first) + second + 2) >> 2); }
+    };
+
+    template <>
+    struct HalveArithmetic<float>
+    {
+        typedef float Sum;
+        static float average(float first, float second) { return (first + second) * 0.25f; }
+    };
+
+    template <int C, typename T>
+    static void halveKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst)
+    {
+        typedef HalveArithmetic<T> Arithmetic;
+        typedef typename Arithmetic::Sum Sum;
+
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+        const int width = dst.width;
+        const int BAND_HEIGHT = 32;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(static) if(ImageBase::useParallelization)
         #endif
-        {
-            // Versión secuencial
-            for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
-                for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
-                    // Definir los límites del bloque
-                    int endY = std::min(blockY + BLOCK_SIZE, height);
-                    int endX = std::min(blockX + BLOCK_SIZE, width);
-                    int blockH = endY - blockY;
-                    int blockW = endX - blockX;
-                    
-                    // Pre-calcular coordenadas de origen para todo el bloque
-                    for (int y = 0; y < blockH; y++) {
-                        for (int x = 0; x < blockW; x++) {
-                            // Coordenadas en la imagen de destino
-                            int destX = blockX + x;
-                            int destY = blockY + y;
-                            
-                            // Trasladar al origen (centro de la imagen)
-                            float xOffset = destX - centerX;
-                            float yOffset = destY - centerY;
-                            
-                            // Aplicar la rotación inversa
-                            srcX[y * blockW + x] = xOffset * cosAngle + yOffset * sinAngle + centerX;
-                            srcY[y * blockW + x] = -xOffset * sinAngle + yOffset * cosAngle + centerY;
+        for (int p = 0; p < planes; p++) {
+            for (int bandY = 0; bandY < dst.height; bandY += BAND_HEIGHT) {
+                const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+                const int endY = std::min(bandY + BAND_HEIGHT, dst.height);
+
+                // Suma vertical de las dos filas (contigua, se vectoriza entera) y
+                // después suma de los pares de columnas
+                static thread_local std::vector<Sum> sums;
+                sums.resize((size_t)2 * width * channels);
+
+                for (int y = bandY; y < endY; y++) {
+                    if (src.isTiled() || dst.isTiled()) {
+                        for (int x = 0; x < width; x++) {
+                            const T *p00 = srcPlane.pixelAt(2 * x, 2 * y);
+                            const T *p10 = srcPlane.pixelAt(2 * x + 1, 2 * y);
+                            const T *p01 = srcPlane.pixelAt(2 * x, 2 * y + 1);
+                            const T *p11 = srcPlane.pixelAt(2 * x + 1, 2 * y + 1);
+                            T *out = dstPlane.pixelAt(x, y);
+                            for (int c = 0; c < channels; c++) {
+                                out[c] = Arithmetic::average(Sum(p00[c]) + p01[c], Sum(p10[c]) + p11[c]);
+                            }
                         }
+                        continue;
                     }
-                    
-                    // Procesar el bloque completo
-                    for (int y = 0; y < blockH; y++) {
-                        for (int x = 0; x < blockW; x++) {
-                            // Para cada píxel en el bloque
-                            for (int c = 0; c < channels; c++) {  // Corregido aquí, eliminado el 'a'
-                                rotatedImage.pixels[blockY + y][blockX + x][c] = 
-                                    bilinearInterpolation(srcX[y * blockW + x], srcY[y * blockW + x], c);
-                            }
+
+                    const T *top = srcPlane.row(2 * y);
+                    const T *bottom = srcPlane.row(2 * y + 1);
+                    Sum *sum = sums.data();
+                    for (int i = 0; i < 2 * width * channels; i++) {
+                        sum[i] = Sum(top[i]) + bottom[i];
+                    }
+
+                    T *out = dstPlane.row(y);
+                    for (int x = 0; x < width; x++) {
+                        for (int c = 0; c < channels; c++) {
+                            const int i = 2 * x * channels + c;
+                            out[x * channels + c] = Arithmetic::average(sum[i], sum[i + channels]);
                         }
                     }
                 }
             }
         }
-    
-        // Liberar buffers temporales
-        delete[] srcX;
-        delete[] srcY;
-        delete[] outBuffer;
-    
-        // Copiar la imagen rotada de vuelta a la imagen original
-        *this = rotatedImage;
-    
-        std::cout << "[INFO] Imagen rotada " << angleDegrees << " grados." << std::endl;
-        std::cout << "---------------------------------" << std::endl;
     }
 
-    void Image::scaleImage(float factor)
+    template <typename T>
+    void halve(const ImageViewT<T> &src, const ImageViewT<T> &dst)
+    {
+        switch (src.isPlanar() ? 0 : src.channels) {
+            case 1:  halveKernel<1>(src, dst); break;
+            case 2:  halveKernel<2>(src, dst); break;
+            case 3:  halveKernel<3>(src, dst); break;
+            case 4:  halveKernel<4>(src, dst); break;
+            default: halveKernel<0>(src, dst); break;
+        }
+    }
+
+    template <typename T>
+    void MipPyramidT<T>::build(const ImageT<T> &image, int minSize)
     {
-        // Calcular las nuevas dimensiones
-        int newWidth  = static_cast<int>(width * factor);
-        int newHeight = static_cast<int>(height * factor);
+        size_t count = 1;
+        for (int w = image.width, h = image.height; w / 2 >= std::max(1, minSize) && h / 2 >= std::max(1, minSize);
+             w /= 2, h /= 2) {
+            count++;
+        }
 
-        // Crear una nueva imagen con las dimensiones escaladas
-        Image scaledImage;
-        scaledImage.width    = newWidth;
-        scaledImage.height   = newHeight;
-        scaledImage.channels = channels;
-        scaledImage.allocateMemory(usingBuddySystem); // Usar el mismo método de memoria
+        // Al reconstruir con una imagen del mismo tamaño los niveles reutilizan su memoria
+        levels.resize(count);
+        levels[0] = image;
 
-        // Optimizado: procesar la imagen en bloques para mejor uso de caché
-        const int BLOCK_SIZE = 32; // Tamaño óptimo para escalado
+        for (size_t i = 1; i < count; i++) {
+            const ImageT<T> &previous = levels[i - 1];
+            ImageT<T> &next = levels[i];
+            next.width    = previous.width / 2;
+            next.height   = previous.height / 2;
+            next.channels = previous.channels;
+            next.layout   = previous.layout;
+            next.tileSize = previous.tileSize;
+            next.ensureMemory(previous.usingBuddySystem);
+
+            halve(previous.view(), next.view());
+        }
+    }
+
+    template <typename T>
+    void MipPyramidT<T>::resizeTo(ImageT<T> &dst, int outWidth, int outHeight) const
+    {
+        // Nivel más pequeño que mide al menos el doble del destino en los dos ejes:
+        // cada píxel de dst promedia dos o más píxeles del nivel y los bloques de
+        // 2x2 que cruzan el borde de su área pesan poco
+        size_t index = 0;
+        while (index + 1 < levels.size() && levels[index + 1].width >= 2 * outWidth &&
+               levels[index + 1].height >= 2 * outHeight) {
+            index++;
+        }
+        levels[index].resizeTo(dst, outWidth, outHeight);
+    }
+
+    // Recolocación exacta de píxeles (giros de 90 grados y volteos): el píxel (X, Y)
+    // de dst copia el (x0 + X * xx + Y * xy, y0 + X * yx + Y * yy) de src, con
+    // coeficientes 0, 1 o -1
+    struct PixelMapping
+    {
+        int x0, xx, xy;
+        int y0, yx, yy;
+    };
+
+    // Kernels vectoriales de remapKernel (ver remap_simd.h): sólo muestras de 8 bits
+    // sin teselas. Devuelven false si no aplican (el llamador copia en escalar).
+    template <typename T>
+    static inline bool simdTranspose(const ImageViewT<T> &, const ImageViewT<T> &, const PixelMapping &,
+                                     int, int, int, int)
+    {
+        return false;
+    }
+
+    static inline bool simdTranspose(const ImageView &src, const ImageView &dst, const PixelMapping &map,
+                                     int blockX, int blockY, int width, int height)
+    {
+        // Giros de 90 y 270 grados: cada columna de dst es un tramo de fila de src
+        const int sx = map.x0 + blockX * map.xx + blockY * map.xy;
+        const int sy = map.y0 + blockX * map.yx + blockY * map.yy;
+        return map.xx == 0 && map.yy == 0 &&
+               RemapSimd::transposeBlock(src.pixel(sx, sy), (ptrdiff_t)map.yx * (ptrdiff_t)src.stride,
+                                         map.xy * src.channels, src.channels, dst.pixel(blockX, blockY),
+                                         dst.stride, width, height);
+    }
+
+    template <typename T>
+    static inline bool simdReverse(const T *, int, T *, int)
+    {
+        return false;
+    }
+
+    static inline bool simdReverse(const uint8_t *in, int channels, uint8_t *out, int n)
+    {
+        return RemapSimd::reverseRow(in, channels, out, n);
+    }
+
+    // Copia sin interpolar según map. Se recorre dst por bloques de 32x32 como en
+    // affineKernel: al girar 90 grados cada fila de dst lee una columna de src, y
+    // con bloques pequeños las líneas de caché de src que trae una fila siguen ahí
+    // para las siguientes. Con las filas de src en su orden (volteo vertical) cada
+    // tramo es una copia contigua.
+    template <int C, typename T>
+    static void remapKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, const PixelMapping &map)
+    {
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+
+        // Avance en src (sin teselas) por cada píxel de una fila de dst
+        const ptrdiff_t step = (ptrdiff_t)map.xx * channels + (ptrdiff_t)map.yx * (ptrdiff_t)src.stride;
+
+        // Trasposiciones y filas invertidas con SSE4.1 (8 bits, 1, 3 o 4 canales)
+        const bool simd = ImageBase::simdLevel >= BilinearSimd::Level::SSE41;
+
+        const int BLOCK_SIZE = 32;
+        const int gridOffset = dst.isTiled() ? (dst.originX & (BLOCK_SIZE - 1)) : 0;
 
         #if defined(_OPENMP)
-        if (useParallelization) {
-            #pragma omp parallel for collapse(2) schedule(dynamic, 4)
-            for (int blockY = 0; blockY < newHeight; blockY += BLOCK_SIZE) {
-                for (int blockX = 0; blockX < newWidth; blockX += BLOCK_SIZE) {
-                    // Definir los límites del bloque
-                    int endY = std::min(blockY + BLOCK_SIZE, newHeight);
-                    int endX = std::min(blockX + BLOCK_SIZE, newWidth);
-                    
+        #pragma omp parallel for collapse(2) schedule(dynamic, 4) if(ImageBase::useParallelization)
+        #endif
+        for (int blockY = 0; blockY < dst.height; blockY += BLOCK_SIZE) {
+            for (int gridX = 0; gridX < dst.width + gridOffset; gridX += BLOCK_SIZE) {
+                const int blockX = std::max(0, gridX - gridOffset);
+                const int endY = std::min(blockY + BLOCK_SIZE, dst.height);
+                const int count = std::min(gridX - gridOffset + BLOCK_SIZE, dst.width) - blockX;
+
+                for (int p = 0; p < planes; p++) {
+                    const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                    const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+
+                    if (simd && !srcPlane.isTiled() && !dstPlane.isTiled() &&
+                        simdTranspose(srcPlane, dstPlane, map, blockX, blockY, count, endY - blockY)) {
+                        continue;
+                    }
+
                     for (int y = blockY; y < endY; y++) {
-                        for (int x = blockX; x < endX; x++) {
-                            // Calcular las coordenadas en la imagen original
-                            float srcX = x / factor;
-                            float srcY = y / factor;
-                            
-                            if (srcX < 0 || srcY < 0 || srcX >= width - 1 || srcY >= height - 1) {
+                        int sx = map.x0 + blockX * map.xx + y * map.xy;
+                        int sy = map.y0 + blockX * map.yx + y * map.yy;
+                        T *out = dstPlane.pixelAt(blockX, y);
+
+                        if (srcPlane.isTiled()) {
+                            for (int x = 0; x < count; x++, sx += map.xx, sy += map.yx, out += channels) {
+                                const T *in = srcPlane.tiledPixel(sx, sy);
                                 for (int c = 0; c < channels; c++) {
-                                    scaledImage.pixels[y][x][c] = 0;
+                                    out[c] = in[c];
                                 }
-                                continue;
                             }
-                            
-                            int x1 = static_cast<int>(srcX);
-                            int y1 = static_cast<int>(srcY);
-                            int x2 = x1 + 1;
-                            int y2 = y1 + 1;
-                            
-                            float dx = srcX - x1;
-                            float dy = srcY - y1;
-                            float w1 = (1.0f - dx) * (1.0f - dy);
-                            float w2 = dx * (1.0f - dy);
-                            float w3 = (1.0f - dx) * dy;
-                            float w4 = dx * dy;
-                            
-                            for (int c = 0; c < channels; c++) {
-                                unsigned char p1 = pixels[y1][x1][c];
-                                unsigned char p2 = pixels[y1][x2][c];
-                                unsigned char p3 = pixels[y2][x1][c];
-                                unsigned char p4 = pixels[y2][x2][c];
-                                
-                                float value = w1 * p1 + w2 * p2 + w3 * p3 + w4 * p4;
-                                scaledImage.pixels[y][x][c] = 
-                                    static_cast<unsigned char>(std::max(0.0f, std::min(255.0f, value)));
+                        } else if (step == channels) {
+                            const T *in = srcPlane.pixel(sx, sy);
+                            std::copy(in, in + (size_t)count * channels, out);
+                        } else if (!(step == -channels && simd &&
+                                     simdReverse(srcPlane.pixel(sx - count + 1, sy), channels, out, count))) {
+                            const T *in = srcPlane.pixel(sx, sy);
+                            for (int x = 0; x < count; x++, in += step, out += channels) {
+                                for (int c = 0; c < channels; c++) {
+                                    out[c] = in[c];
+                                }
                             }
                         }
                     }
                 }
             }
-        } else 
+        }
+    }
+
+    template <typename T>
+    static void remap(const ImageViewT<T> &src, const ImageViewT<T> &dst, const PixelMapping &map)
+    {
+        switch (src.isPlanar() ? 0 : src.channels) {
+            case 1:  remapKernel<1>(src, dst, map); break;
+            case 2:  remapKernel<2>(src, dst, map); break;
+            case 3:  remapKernel<3>(src, dst, map); break;
+            case 4:  remapKernel<4>(src, dst, map); break;
+            default: remapKernel<0>(src, dst, map); break;
+        }
+    }
+
+    // Número de giros de 90 grados (0-3) si el ángulo es múltiplo exacto de 90; -1 si no
+    static int quarterTurns(float angleDegrees)
+    {
+        if (std::fmod(angleDegrees, 90.0f) != 0.0f) {
+            return -1;
+        }
+        return ((int)(angleDegrees / 90.0f) % 4 + 4) % 4;
+    }
+
+    template <typename T>
+    void rotateRightAngle(const ImageViewT<T> &src, const ImageViewT<T> &dst, int quarterTurns)
+    {
+        const int right = src.width - 1, bottom = src.height - 1;
+        PixelMapping map;
+
+        // El sentido es el de AffineTransform::rotation: 90 grados lleva (x, y) a
+        // (alto - 1 - y, x)
+        switch ((quarterTurns % 4 + 4) % 4) {
+            case 1:  map = {0, 0, 1, bottom, -1, 0}; break;
+            case 2:  map = {right, -1, 0, bottom, 0, -1}; break;
+            case 3:  map = {right, 0, -1, 0, 1, 0}; break;
+            default: map = {0, 1, 0, 0, 0, 1}; break;
+        }
+        remap(src, dst, map);
+    }
+
+    template <typename T>
+    void flip(const ImageViewT<T> &src, const ImageViewT<T> &dst, bool horizontal, bool vertical)
+    {
+        PixelMapping map = {0, 1, 0, 0, 0, 1};
+        if (horizontal) {
+            map.x0 = src.width - 1;
+            map.xx = -1;
+        }
+        if (vertical) {
+            map.y0 = src.height - 1;
+            map.yy = -1;
+        }
+        remap(src, dst, map);
+    }
+
+    // Rotación por tres cizallas (Paeth): la rotación de a grados es X(t) Y(s) X(t)
+    // con t = -tan(a / 2) y s = sin(a), donde X desplaza cada fila en horizontal y
+    // Y cada columna en vertical. Cada pasada es un desplazamiento 1D con un solo
+    // juego de pesos por fila (o por columna), así que recorre la memoria en orden
+    // en lugar de leer src en diagonal como warpAffine.
+
+    // Pesos del desplazamiento 1D de una fila o columna: la muestra i toma la
+    // posición i + offset de la entrada y su vecino k está en base + i + k. Devuelve
+    // base y añade los TAPS pesos (normalizados, ver storeWeights) a weights.
+    template <int TAPS, typename Arithmetic>
+    static int shiftWeights(double offset, ResampleFilter filter, std::vector<typename Arithmetic::Weight> &weights)
+    {
+        const double whole = std::floor(offset);
+        static thread_local std::vector<double> taps;
+        taps.resize(TAPS);
+        for (int k = 0; k < TAPS; k++) {
+            taps[k] = filterWeight(filter, k - TAPS / 2 + 1 - (offset - whole));
+        }
+        storeWeights<Arithmetic>(taps, weights);
+        return (int)whole - TAPS / 2 + 1;
+    }
+
+    // Cizalla horizontal: dst(x, y) = src(x + offset0 + slope * y, y), con src y dst
+    // de la misma altura. Cada fila de src se copia en una línea con TAPS píxeles
+    // negros a cada lado, de modo que los vecinos fuera de src valen 0 sin
+    // comprobarlo píxel a píxel y los bordes quedan suavizados.
+    template <int C, int TAPS, typename Arithmetic, typename T>
+    static void shearRows(const ImageViewT<T> &src, const ImageViewT<T> &dst, double offset0, double slope,
+                          ResampleFilter filter, const T *constant)
+    {
+        typedef typename Arithmetic::Weight Weight;
+        typedef typename Arithmetic::Partial Partial;
+        typedef typename Arithmetic::Accumulator Accumulator;
+        const Accumulator one = Arithmetic::weight(1.0);
+
+        const int planes = src.isPlanar() ? src.channels : 1;
+        const int channels = (C > 0) ? C : (src.isPlanar() ? 1 : src.channels);
+
+        static thread_local std::vector<int> baseTable;
+        static thread_local std::vector<Weight> weightTable;
+        const std::vector<int> &bases = baseTable;
+        const std::vector<Weight> &weights = weightTable;
+        baseTable.resize(dst.height);
+        weightTable.clear();
+        for (int y = 0; y < dst.height; y++) {
+            baseTable[y] = shiftWeights<TAPS, Arithmetic>(offset0 + slope * y, filter, weightTable);
+        }
+
+        const int BAND_HEIGHT = 32;
+
+        #if defined(_OPENMP)
+        #pragma omp parallel for collapse(2) schedule(dynamic) if(ImageBase::useParallelization)
         #endif
-        {
-            // Versión secuencial con procesamiento por bloques
-            for (int blockY = 0; blockY < newHeight; blockY += BLOCK_SIZE) {
-                for (int blockX = 0; blockX < newWidth; blockX += BLOCK_SIZE) {
-                    // Definir los límites del bloque
-                    int endY = std::min(blockY + BLOCK_SIZE, newHeight);
-                    int endX = std::min(blockX + BLOCK_SIZE, newWidth);
-                    
-                    for (int y = blockY; y < endY; y++) {
-                        for (int x = blockX; x < endX; x++) {
-                            // Calcular las coordenadas en la imagen original
-                            float srcX = x / factor;
-                            float srcY = y / factor;
-                            
-                            // Aplicar interpolación bilineal para cada canal
-                            for (int c = 0; c < channels; c++) {
-                                scaledImage.pixels[y][x][c] = bilinearInterpolation(srcX, srcY, c);
+        for (int p = 0; p < planes; p++) {
+            for (int bandY = 0; bandY < dst.height; bandY += BAND_HEIGHT) {
+                const ImageViewT<T> srcPlane = src.isPlanar() ? src.plane(p) : src;
+                const ImageViewT<T> dstPlane = dst.isPlanar() ? dst.plane(p) : dst;
+                const int endY = std::min(bandY + BAND_HEIGHT, dst.height);
+                const T *pixel = constant + (src.isPlanar() ? p : 0);
+
+                static thread_local std::vector<T> line;
+                line.resize((size_t)(src.width + 2 * TAPS) * channels);
+                fillPixels(line.data(), src.width + 2 * TAPS, pixel, channels);
+                T *const row = line.data() + TAPS * channels;
+
+                for (int y = bandY; y < endY; y++) {
+                    for (int x = 0; x < src.width; ) {
+                        const int run = runLength(srcPlane, x);
+                        const T *in = srcPlane.pixelAt(x, y);
+                        std::copy(in, in + (size_t)run * channels, row + (size_t)x * channels);
+                        x += run;
+                    }
+
+                    // Sólo las posiciones con algún vecino dentro de src no toman el
+                    // color constante
+                    const int base = bases[y];
+                    const Weight *w = weights.data() + (size_t)y * TAPS;
+                    const int first = -TAPS - base, last = src.width - base;
+
+                    for (int x = 0; x < dst.width; ) {
+                        const int run = runLength(dstPlane, x);
+                        const int begin = std::min(std::max(first, x), x + run);
+                        const int end = std::max(std::min(last + 1, x + run), begin);
+                        T *out = dstPlane.pixelAt(x, y);
+
+                        fillPixels(out, begin - x, pixel, channels);
+                        out += (size_t)(begin - x) * channels;
+
+                        // Todos los canales usan los mismos pesos: el tramo se recorre
+                        // muestra a muestra, contiguo, y el bucle se vectoriza
+                        const T *in = row + (ptrdiff_t)(base + begin) * channels;
+                        const int samples = (end - begin) * channels;
+                        for (int j = 0; j < samples; j++) {
+                            Partial partial = 0;
+                            for (int k = 0; k < TAPS; k++) {
+                                partial += w[k] * in[j + k * channels];
                             }
+                            out[j] = Arithmetic::finish(Arithmetic::start() + one * partial);
                         }
+                        out += samples;
+
+                        fillPixels(out, x + run - end, pixel, channels);
+                        x += run;
                     }
                 }
             }
         }
+    }
+
+    // Vista sobre un buffer temporal de width x height, planar o intercalada como
+    // like (nunca en teselas). El buffer debe tener sitio para todas las muestras.
+    template <typename T>
+    static ImageViewT<T> scratchView(T *buffer, int width, int height, const ImageViewT<T> &like)
+    {
+        const size_t planeSize = (size_t)width * height;
+        if (like.isPlanar()) {
+            return ImageViewT<T>(buffer, width, height, like.channels, width, planeSize);
+        }
+        return ImageViewT<T>(buffer, width, height, like.channels, (size_t)width * like.channels);
+    }
+
+    template <int C, int TAPS, typename Arithmetic, typename T>
+    static void shearRotateKernel(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees,
+                                  ResampleFilter filter)
+    {
+        // Las cizallas sólo se usan entre -45 y 45 grados (cerca de 180, tan(a / 2)
+        // crece sin límite); el resto del ángulo es un giro exacto previo
+        const int turns = (int)std::floor(angleDegrees / 90.0 + 0.5);
+        const double residual = (angleDegrees - turns * 90.0) * M_PI / 180.0;
+        const double cx = src.width / 2.0, cy = src.height / 2.0;
+        const int quarterTurns = (turns % 4 + 4) % 4;
+        const bool odd = quarterTurns % 2 == 1;
+        const int quarterWidth = odd ? src.height : src.width;
+        const int quarterHeight = odd ? src.width : src.height;
+
+        const double t = -std::tan(residual / 2.0);
+        const double s = std::sin(residual);
+
+        // Los intermedios tienen margin columnas más a cada lado que dst: la última
+        // cizalla desplaza las filas hasta |t| * (distancia al centro)
+        const double reach = std::max(cy, dst.height - cy);
+        const int margin = (int)std::ceil(std::fabs(t) * reach) + TAPS;
+        const int wide = dst.width + 2 * margin;
+        const double ox = cx + margin;
+
+        // Dos buffers que se alternan entre pasadas, del tamaño de la imagen. Son
+        // static thread_local como el resto de la memoria temporal (a diferencia de
+        // ella no miden una fila sino una imagen) y sólo crecen, así que repetir la
+        // rotación no reserva memoria. Cada pasada escribe todo lo que lee la
+        // siguiente; las vistas apuntan a los del hilo que llama
+        static thread_local std::vector<T> scratchA, scratchB;
+        const size_t largest = (size_t)std::max(quarterWidth, wide) * std::max(quarterHeight, dst.height) * src.channels;
+        if (scratchA.size() < largest) {
+            scratchA.resize(largest);
+            scratchB.resize(largest);
+        }
+        T *const bufferA = scratchA.data();
+        T *const bufferB = scratchB.data();
+
+        // quarter: src tras el giro exacto; (qx, qy): el centro de src en ella
+        ImageViewT<T> quarter = src;
+        double qx = cx, qy = cy;
+        if (quarterTurns != 0) {
+            quarter = scratchView(bufferB, quarterWidth, quarterHeight, src);
+            rotateRightAngle(src, quarter, quarterTurns);
+            switch (quarterTurns) {
+                case 1:  qx = src.height - 1 - cy; qy = cx; break;
+                case 2:  qx = src.width - 1 - cx; qy = src.height - 1 - cy; break;
+                default: qx = cy; qy = src.width - 1 - cx; break;
+            }
+        }
+
+        // Las posiciones fuera de src toman el color de BorderMode::Constant en cada
+        // pasada (ver rotate para los demás modos)
+        const std::vector<T> &constant = borderConstant<T>(src.channels);
+
+        // Primera cizalla: first(i, y) = quarter(i - ox + qx - t * (y - qy), y)
+        const ImageViewT<T> first = scratchView(bufferA, wide, quarterHeight, src);
+        shearRows<C, TAPS, Arithmetic>(quarter, first, qx - ox + t * qy, -t, filter, constant.data());
+
+        // Segunda cizalla, vertical: second(i, y) = first(i, y - cy + qy - s * (i - ox)).
+        // Cada columna usa pesos distintos y leerlas directamente salta de fila en
+        // cada muestra; en la traspuesta las columnas son filas, así que se traspone,
+        // se desplazan las filas y se traspone de vuelta (por bloques, con SSE4.1 en
+        // 8 bits)
+        const PixelMapping transpose = {0, 0, 1, 0, 1, 0};
+        const ImageViewT<T> firstColumns = scratchView(bufferB, quarterHeight, wide, src);
+        remap(first, firstColumns, transpose);
+        const ImageViewT<T> secondColumns = scratchView(bufferA, dst.height, wide, src);
+        shearRows<C, TAPS, Arithmetic>(firstColumns, secondColumns, qy - cy + s * ox, -s, filter, constant.data());
+        const ImageViewT<T> second = scratchView(bufferB, wide, dst.height, src);
+        remap(secondColumns, second, transpose);
+
+        // Tercera cizalla: dst(x, y) = second(x + ox - cx - t * (y - cy), y)
+        shearRows<C, TAPS, Arithmetic>(second, dst, ox - cx + t * cy, -t, filter, constant.data());
+    }
+
+    template <int C, int TAPS, typename T>
+    static void shearRotateFilter(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees,
+                                  ResampleFilter filter)
+    {
+        // Con muestras float ambas ramas usan la aritmética en float
+        if (ImageBase::useIntegerInterpolation) {
+            shearRotateKernel<C, TAPS, FilterArithmetic<T, (FilterFixed<T>::BITS > 0)> >(src, dst, angleDegrees, filter);
+        } else {
+            shearRotateKernel<C, TAPS, FilterArithmetic<T, false> >(src, dst, angleDegrees, filter);
+        }
+    }
+
+    template <int C, typename T>
+    static void shearRotateChannels(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees,
+                                    ResampleFilter filter)
+    {
+        // Vecinos de cada desplazamiento 1D: 2 (lineal, también con el vecino más
+        // cercano), 4 (bicúbico) o 6 (Lanczos-3)
+        switch (filter) {
+            case ResampleFilter::Bicubic:
+                shearRotateFilter<C, 4>(src, dst, angleDegrees, ResampleFilter::Bicubic);
+                break;
+            case ResampleFilter::Lanczos3:
+                shearRotateFilter<C, 6>(src, dst, angleDegrees, ResampleFilter::Lanczos3);
+                break;
+            default:
+                shearRotateFilter<C, 2>(src, dst, angleDegrees, ResampleFilter::Bilinear);
+                break;
+        }
+    }
+
+    template <typename T>
+    void rotateShear(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees, ResampleFilter filter)
+    {
+        switch (src.isPlanar() ? 0 : src.channels) {
+            case 1:  shearRotateChannels<1>(src, dst, angleDegrees, filter); break;
+            case 2:  shearRotateChannels<2>(src, dst, angleDegrees, filter); break;
+            case 3:  shearRotateChannels<3>(src, dst, angleDegrees, filter); break;
+            case 4:  shearRotateChannels<4>(src, dst, angleDegrees, filter); break;
+            default: shearRotateChannels<0>(src, dst, angleDegrees, filter); break;
+        }
+    }
+
+    // Rotación alrededor del centro de src seguida de escalado desde el origen
+    static AffineTransform rotateScaleTransform(int srcWidth, int srcHeight, float angleDegrees, float factor)
+    {
+        return AffineTransform::rotation(angleDegrees, srcWidth / 2.0f, srcHeight / 2.0f)
+            .then(AffineTransform::scaling(factor, factor));
+    }
+
+    template <typename T>
+    void rotate(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees, ResampleFilter filter)
+    {
+        // Las cizallas sólo saben rellenar con un color constante: replicar, reflejar
+        // y mosaico necesitan la posición final en src de cada píxel. Con el vecino
+        // más cercano la rotación directa ya es una sola copia por píxel.
+        if (ImageBase::rotationEngine == RotationEngine::Shear && ImageBase::borderMode == BorderMode::Constant &&
+            filter != ResampleFilter::Nearest) {
+            rotateShear(src, dst, angleDegrees, filter);
+            return;
+        }
+        warpAffine(src, dst, AffineTransform::rotation(angleDegrees, src.width / 2.0f, src.height / 2.0f), filter);
+    }
+
+    template <typename T>
+    void scale(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factor, ResampleFilter filter)
+    {
+        resize(src, dst, factor, factor, filter);
+    }
+
+    template <typename T>
+    void rotateScale(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees, float factor,
+                     ResampleFilter filter)
+    {
+        warpAffine(src, dst, rotateScaleTransform(src.width, src.height, angleDegrees, factor), filter);
+    }
+
+    template <typename T>
+    void ImageT<T>::rotateImage(float angleDegrees)
+    {
+        // Rotar en una imagen temporal y quedarse con su buffer (sin copia)
+        ImageT rotatedImage;
+        rotateTo(rotatedImage, angleDegrees);
+        *this = std::move(rotatedImage);
+
+        std::cout << "[INFO] Imagen rotada " << angleDegrees << " grados." << std::endl;
+        std::cout << "---------------------------------" << std::endl;
+    }
+
+    template <typename T>
+    void ImageT<T>::rotateTo(ImageT &rotatedImage, float angleDegrees, ResampleFilter filter) const
+    {
+        // La operación no puede hacerse sobre la propia imagen de origen
+        if (&rotatedImage == this)
+        {
+            ImageT result;
+            rotateTo(result, angleDegrees, filter);
+            rotatedImage = std::move(result);
+            return;
+        }
 
-        // Copiar la imagen escalada de vuelta a la imagen original
-        *this = scaledImage;
+        // Múltiplos de 90 grados: giro exacto sin remuestreo, con ancho y alto
+        // intercambiados en los giros de 90 y 270
+        const int turns = quarterTurns(angleDegrees);
+
+        // Preparar la imagen destino con las mismas dimensiones
+        rotatedImage.width    = (turns % 2 == 1) ? height : width;
+        rotatedImage.height   = (turns % 2 == 1) ? width : height;
+        rotatedImage.channels = channels;
+        rotatedImage.layout   = layout;
+        rotatedImage.tileSize = tileSize;
+        rotatedImage.ensureMemory(usingBuddySystem); // Usar el mismo método de memoria
+
+        if (turns >= 0) {
+            rotateRightAngle(view(), rotatedImage.view(), turns);
+        } else {
+            rotate(view(), rotatedImage.view(), angleDegrees, filter);
+        }
+    }
+
+    template <typename T>
+    void ImageT<T>::flipTo(ImageT &dst, bool horizontal, bool vertical) const
+    {
+        // La operación no puede hacerse sobre la propia imagen de origen
+        if (&dst == this)
+        {
+            ImageT result;
+            flipTo(result, horizontal, vertical);
+            dst = std::move(result);
+            return;
+        }
+
+        dst.width    = width;
+        dst.height   = height;
+        dst.channels = channels;
+        dst.layout   = layout;
+        dst.tileSize = tileSize;
+        dst.ensureMemory(usingBuddySystem); // Usar el mismo método de memoria
+
+        flip(view(), dst.view(), horizontal, vertical);
+    }
+
+    template <typename T>
+    void ImageT<T>::scaleImage(float factor)
+    {
+        // Escalar en una imagen temporal y quedarse con su buffer (sin copia)
+        ImageT scaledImage;
+        scaleTo(scaledImage, factor);
+        *this = std::move(scaledImage);
 
         std::cout << "[INFO] Imagen escalada con factor " << factor << ". ";
-        std::cout << "Nuevas dimensiones: " << newWidth << " x " << newHeight << std::endl;
+        std::cout << "Nuevas dimensiones: " << width << " x " << height << std::endl;
         std::cout << "---------------------------------" << std::endl;
     }
 
-} // namespace ImageProcessor
\ No newline at end of file
+    template <typename T>
+    void ImageT<T>::scaleTo(ImageT &scaledImage, float factor, ResampleFilter filter) const
+    {
+        scaleTo(scaledImage, factor, factor, filter);
+    }
+
+    template <typename T>
+    void ImageT<T>::scaleTo(ImageT &scaledImage, float factorX, float factorY, ResampleFilter filter) const
+    {
+        resizeTo(scaledImage, static_cast<int>(width * factorX), static_cast<int>(height * factorY),
+                 factorX, factorY, filter);
+    }
+
+    template <typename T>
+    void ImageT<T>::resizeTo(ImageT &dst, int outWidth, int outHeight, ResampleFilter filter) const
+    {
+        resizeTo(dst, outWidth, outHeight, (float)outWidth / width, (float)outHeight / height, filter);
+    }
+
+    template <typename T>
+    void ImageT<T>::resizeTo(ImageT &dst, int outWidth, int outHeight, float factorX, float factorY,
+                             ResampleFilter filter) const
+    {
+        // La operación no puede hacerse sobre la propia imagen de origen
+        if (&dst == this)
+        {
+            ImageT result;
+            resizeTo(result, outWidth, outHeight, factorX, factorY, filter);
+            dst = std::move(result);
+            return;
+        }
+
+        // Preparar la imagen destino con las dimensiones pedidas
+        dst.width    = outWidth;
+        dst.height   = outHeight;
+        dst.channels = channels;
+        dst.layout   = layout;
+        dst.tileSize = tileSize;
+        dst.ensureMemory(usingBuddySystem); // Usar el mismo método de memoria
+
+        resize(view(), dst.view(), factorX, factorY, filter);
+    }
+
+    template <typename T>
+    void ImageT<T>::rotateScaleTo(ImageT &dst, float angleDegrees, float factor, ResampleFilter filter) const
+    {
+        // La operación no puede hacerse sobre la propia imagen de origen
+        if (&dst == this)
+        {
+            ImageT result;
+            rotateScaleTo(result, angleDegrees, factor, filter);
+            dst = std::move(result);
+            return;
+        }
+
+        // Directamente con el tamaño final, como scaleTo. Los giros de 90 y 270
+        // grados intercambian ancho y alto, como en rotateTo
+        const bool swapped = quarterTurns(angleDegrees) % 2 == 1;
+        dst.width    = static_cast<int>((swapped ? height : width) * factor);
+        dst.height   = static_cast<int>((swapped ? width : height) * factor);
+        dst.channels = channels;
+        dst.layout   = layout;
+        dst.tileSize = tileSize;
+        dst.ensureMemory(usingBuddySystem); // Usar el mismo método de memoria
+
+        if (swapped) {
+            // Girar alrededor del centro de src y llevarlo al centro del lienzo girado
+            const float shift = (height - width) / 2.0f;
+            warpAffine(view(), dst.view(),
+                       AffineTransform::rotation(angleDegrees, width / 2.0f, height / 2.0f)
+                           .then(AffineTransform::translation(shift, -shift))
+                           .then(AffineTransform::scaling(factor, factor)),
+                       filter);
+        } else {
+            rotateScale(view(), dst.view(), angleDegrees, factor, filter);
+        }
+    }
+
+    template <typename T>
+    void ImageT<T>::warpAffineTo(ImageT &dst, const AffineTransform &transform, int outWidth, int outHeight,
+                                 ResampleFilter filter) const
+    {
+        // La operación no puede hacerse sobre la propia imagen de origen
+        if (&dst == this)
+        {
+            ImageT result;
+            warpAffineTo(result, transform, outWidth, outHeight, filter);
+            dst = std::move(result);
+            return;
+        }
+
+        dst.width    = outWidth;
+        dst.height   = outHeight;
+        dst.channels = channels;
+        dst.layout   = layout;
+        dst.tileSize = tileSize;
+        dst.ensureMemory(usingBuddySystem); // Usar el mismo método de memoria
+
+        warpAffine(view(), dst.view(), transform, filter);
+    }
+
+    // Instanciaciones explícitas para los tipos de muestra soportados: cada kernel
+    // se compila por separado para cada tipo, sin saltos por tipo en los bucles
+    #define INSTANTIATE_SAMPLE_TYPE(T)                                                          \
+        template class ImageT<T>;                                                               \
+        template void rotate<T>(const ImageViewT<T> &, const ImageViewT<T> &, float, ResampleFilter); \
+        template void scale<T>(const ImageViewT<T> &, const ImageViewT<T> &, float, ResampleFilter); \
+        template void resize<T>(const ImageViewT<T> &, const ImageViewT<T> &, float, float, ResampleFilter); \
+        template void halve<T>(const ImageViewT<T> &, const ImageViewT<T> &);                    \
+        template class MipPyramidT<T>;                                                          \
+        template void rotateScale<T>(const ImageViewT<T> &, const ImageViewT<T> &, float, float, ResampleFilter); \
+        template void warpAffine<T>(const ImageViewT<T> &, const ImageViewT<T> &, const AffineTransform &,  \
+                                    ResampleFilter);                                            \
+        template void rotateRightAngle<T>(const ImageViewT<T> &, const ImageViewT<T> &, int);   \
+        template void flip<T>(const ImageViewT<T> &, const ImageViewT<T> &, bool, bool);        \
+        template void rotateShear<T>(const ImageViewT<T> &, const ImageViewT<T> &, float, ResampleFilter); \
+        template void convertLayout<T>(const ImageViewT<T> &, const ImageViewT<T> &);           \
+        template T bilinearSample<T>(const ImageViewT<T> &, float, float, int);
+
+    INSTANTIATE_SAMPLE_TYPE(uint8_t)
+    INSTANTIATE_SAMPLE_TYPE(uint16_t)
+    INSTANTIATE_SAMPLE_TYPE(float)
+
+    #undef INSTANTIATE_SAMPLE_TYPE
+
+} // namespace ImageProcessor
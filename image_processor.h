@@ -1,76 +1,580 @@
 #ifndef IMAGE_PROCESSOR_H
 #define IMAGE_PROCESSOR_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <cstddef>
+#include "bilinear_simd.h"
 #include "buddy_system.h"
 
 namespace ImageProcessor
 {
-    // Estructura para representar una imagen como matriz tridimensional
-    class Image
+    // Alineación del buffer de píxeles y de cada fila (una línea de caché)
+    const size_t PIXEL_ALIGNMENT = 64;
+
+    // Lado por defecto de las teselas (en píxeles)
+    const int DEFAULT_TILE_SIZE = 32;
+
+    // Disposición de las muestras en memoria
+    enum class PixelLayout
+    {
+        Interleaved, // RGBRGB... en cada fila (el formato de los archivos)
+        Planar,      // Un plano por canal: RRR... GGG... BBB...
+        Tiled,       // Teselas cuadradas de píxeles intercalados, teselas fila a fila
+        TiledMorton  // Igual, pero las teselas siguen el orden Z (Morton)
+    };
+
+    inline bool isTiledLayout(PixelLayout layout)
+    {
+        return layout == PixelLayout::Tiled || layout == PixelLayout::TiledMorton;
+    }
+
+    // Filtro de remuestreo de warpAffine y resize, de menor a mayor calidad
+    enum class ResampleFilter
+    {
+        Nearest,  // El píxel más cercano, sin interpolar (vistas previas, preprocesado)
+        Bilinear, // 2x2 vecinos (al reducir con resize, promedio de área)
+        Bicubic,  // 4x4 vecinos, cúbica de Keys (a = -0.5)
+        Lanczos3  // 6x6 vecinos, sinc enventanada de radio 3
+    };
+
+    const char* filterName(ResampleFilter filter);
+
+    // Método de rotate para los ángulos que no son múltiplos de 90
+    enum class RotationEngine
+    {
+        Direct, // warpAffine: cada píxel de dst muestrea src en la posición rotada
+        Shear   // Tres cizallas 1D (Paeth), ver rotateShear
+    };
+
+    const char* engineName(RotationEngine engine);
+
+    // Valor de los vecinos que caen fuera de src en las operaciones geométricas
+    enum class BorderMode
+    {
+        Constant, // Un color fijo (ImageBase::borderColor, por defecto negro)
+        Clamp,    // Repite el píxel del borde
+        Reflect,  // Espejo que repite el píxel del borde: c b a | a b c
+        Wrap      // La imagen se repite como un mosaico
+    };
+
+    const char* borderName(BorderMode mode);
+
+    // Propiedades de cada tipo de muestra soportado. fromFloat convierte el valor
+    // interpolado al tipo de la muestra (saturando en los tipos enteros); white es
+    // el valor del blanco.
+    template <typename T>
+    struct SampleTraits;
+
+    template <>
+    struct SampleTraits<uint8_t>
+    {
+        static const char* name() { return "8 bits"; }
+        static float white() { return 255.0f; }
+        static uint8_t fromFloat(float value)
+        {
+            return static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, value)));
+        }
+    };
+
+    template <>
+    struct SampleTraits<uint16_t>
+    {
+        static const char* name() { return "16 bits"; }
+        static float white() { return 65535.0f; }
+        static uint16_t fromFloat(float value)
+        {
+            return static_cast<uint16_t>(std::max(0.0f, std::min(65535.0f, value)));
+        }
+    };
+
+    // Datos científicos: sin saturación, cualquier rango es válido
+    template <>
+    struct SampleTraits<float>
+    {
+        static const char* name() { return "float"; }
+        static float white() { return 1.0f; }
+        static float fromFloat(float value) { return value; }
+    };
+
+    // Vista ligera (no propietaria) sobre píxeles con stride por fila.
+    // Es lo que reciben los kernels y FileIO; copiarla no copia los píxeles.
+    template <typename T>
+    struct ImageViewT
+    {
+        T* data;
+        int width;
+        int height;
+        int channels;
+        size_t stride;      // Muestras entre el inicio de dos filas consecutivas (de una tesela)
+        size_t planeStride; // Muestras entre planos; 0 si los canales están intercalados
+
+        // Disposición en teselas: log2 del lado de la tesela (0 si no hay teselas),
+        // teselas por fila y posición de cada tesela en data (rejilla fila a fila)
+        int tileShift;
+        int tileColumns;
+        const size_t* tileOffsets;
+
+        // Esquina de la vista dentro de la rejilla de teselas (regiones de una vista
+        // en teselas; sin teselas la región sólo desplaza data)
+        int originX;
+        int originY;
+
+        ImageViewT()
+            : data(nullptr), width(0), height(0), channels(0), stride(0), planeStride(0),
+              tileShift(0), tileColumns(0), tileOffsets(nullptr), originX(0), originY(0)
+        {
+        }
+
+        ImageViewT(T* data, int width, int height, int channels, size_t stride,
+                   size_t planeStride = 0)
+            : data(data), width(width), height(height), channels(channels), stride(stride),
+              planeStride(planeStride), tileShift(0), tileColumns(0), tileOffsets(nullptr),
+              originX(0), originY(0)
+        {
+        }
+
+        bool isPlanar() const { return planeStride != 0; }
+        bool isTiled() const { return tileShift != 0; }
+
+        // Plano de un canal como vista de un solo canal (sólo en disposición planar)
+        ImageViewT plane(int c) const { return ImageViewT(data + c * planeStride, width, height, 1, stride); }
+
+        T* row(int y) const { return data + y * stride; }
+        T* pixel(int x, int y) const { return row(y) + x * channels; }
+
+        // Píxel (x, y) en disposición en teselas
+        T* tiledPixel(int x, int y) const
+        {
+            const int mask = (1 << tileShift) - 1;
+            x += originX;
+            y += originY;
+            return data + tileOffsets[(y >> tileShift) * tileColumns + (x >> tileShift)]
+                        + (y & mask) * stride + (x & mask) * channels;
+        }
+
+        // Píxel de una vista intercalada o en teselas; los píxeles siguientes de la
+        // fila son contiguos hasta el final de la tesela
+        T* pixelAt(int x, int y) const { return isTiled() ? tiledPixel(x, y) : pixel(x, y); }
+
+        // Región (x, y, w, h) de la vista, que debe quedar dentro de ella. Comparte
+        // los píxeles (mismo stride), así que es O(1) en cualquier disposición.
+        ImageViewT region(int x, int y, int w, int h) const
+        {
+            ImageViewT roi = *this;
+            roi.width  = w;
+            roi.height = h;
+            if (isTiled()) {
+                roi.originX += x;
+                roi.originY += y;
+            } else {
+                roi.data += y * stride + (size_t)x * (isPlanar() ? 1 : channels);
+            }
+            return roi;
+        }
+    };
+
+    // Transformación afín 2x3: (x, y) -> (m[0]*x + m[1]*y + m[2], m[3]*x + m[4]*y + m[5]).
+    // Las coordenadas son de píxel (el píxel (0, 0) está en el origen) con y hacia abajo.
+    struct AffineTransform
+    {
+        float m[6];
+
+        static AffineTransform identity();
+        static AffineTransform translation(float tx, float ty);
+        static AffineTransform scaling(float sx, float sy);
+        static AffineTransform shear(float shx, float shy);
+
+        // Rotación en el sentido de rotateImage alrededor de (cx, cy)
+        static AffineTransform rotation(float angleDegrees, float cx, float cy);
+
+        // Aplica primero esta transformación y después next
+        AffineTransform then(const AffineTransform &next) const;
+
+        // Transformación inversa; lanza std::invalid_argument si no es invertible
+        AffineTransform inverse() const;
+
+        void apply(float x, float y, float &outX, float &outY) const
+        {
+            outX = m[0] * x + m[1] * y + m[2];
+            outY = m[3] * x + m[4] * y + m[5];
+        }
+
+        // Lienzo ampliado: ajusta la transformación para que la imagen width x height
+        // transformada empiece en (0, 0) y devuelve en outWidth/outHeight el tamaño
+        // que contiene sus cuatro esquinas
+        AffineTransform expandCanvas(int width, int height, int &outWidth, int &outHeight) const;
+    };
+
+    typedef ImageViewT<uint8_t>  ImageView;
+    typedef ImageViewT<uint16_t> ImageView16;
+    typedef ImageViewT<float>    ImageViewF;
+
+    // Configuración común a las imágenes de cualquier tipo de muestra
+    class ImageBase
     {
         public:
+            // Flag para activar/desactivar paralelización
+            static bool useParallelization;
+
+            // Número de hilos a utilizar (por defecto 4)
+            static int numThreads;
+
+            // Interpolación bilineal con pesos enteros en las muestras de 8 y 16 bits
+            // (por defecto); false usa la ruta en float. Ambas difieren como mucho en 1.
+            static bool useIntegerInterpolation;
+
+            // Juego de instrucciones de los kernels bilineales vectoriales de warpAffine
+            // (8 bits, 3 o 4 canales intercalados; el escalado sin rotación usa resize,
+            // separable y sin ellos) y de los giros exactos (SSE4.1, 8 bits, 1, 3 o 4
+            // canales). Se detecta al arrancar; Scalar los desactiva.
+            static BilinearSimd::Level simdLevel;
+
+            // Filtro por defecto de las operaciones geométricas (bilineal si no se
+            // cambia). Bicúbico y Lanczos-3 dan un resultado más nítido a cambio de
+            // leer más vecinos; el vecino más cercano sólo copia muestras. Cada
+            // operación recibe además su propio filtro, que toma este valor si no se
+            // indica (se lee en cada llamada).
+            static ResampleFilter resampleFilter;
+
+            // Método de las rotaciones (por defecto directa); la suite 'cizalla' del
+            // benchmark compara ambos por ángulo y tamaño
+            static RotationEngine rotationEngine;
+
+            // Tratamiento de los vecinos fuera de src en warpAffine, rotate y
+            // rotateScale (por defecto Constant). Con Constant los píxeles cuyos
+            // vecinos caen todos fuera toman borderColor y los del contorno se mezclan
+            // con él; con los demás modos no hay posiciones fuera de la imagen.
+            static BorderMode borderMode;
+
+            // Color de BorderMode::Constant por canal, de 0 (negro) a 1 (blanco)
+            static float borderColor[4];
+
+            // Establecer uso de paralelización y número de hilos
+            static void setParallelization(bool use, int threads = 4);
+    };
+
+    // Estructura para representar una imagen en un buffer contiguo por filas.
+    // T es el tipo de muestra: uint8_t, uint16_t o float (instanciados en
+    // image_processor.cpp).
+    template <typename T>
+    class ImageT : public ImageBase
+    {
+        public:
+            typedef T Sample;
+
             int width;
             int height;
             int channels;
 
-            // Matriz tridimensional para los píxeles
-            unsigned char ***pixels;
-            
+            // Buffer contiguo y alineado con todos los píxeles (fila a fila). Acceso
+            // directo, sin copia al escribir: para modificar píxeles fuera de los
+            // kernels se usan pixels(), row() o pixel(), que hacen detach()
+            T* data;
+
+            // Inicio del bloque reservado; tras un crop sin copia data apunta dentro de
+            // él y el bloque se comparte con la imagen original
+            T* allocationBase;
+
+            // Disposición de los canales; se aplica en la siguiente reserva de memoria
+            PixelLayout layout;
+
+            // Muestras por fila, redondeado para que cada fila empiece alineada a
+            // PIXEL_ALIGNMENT bytes (>= width * channels, o >= width en disposición
+            // planar); en teselas, muestras por fila de tesela. Los buffers de
+            // adoptBuffer y wrapBuffer conservan el stride de quien los creó, que puede
+            // no estar alineado (los kernels no suponen alineación, sólo rinden más)
+            size_t stride;
+
+            // Muestras entre planos (0 en disposición intercalada)
+            size_t planeStride;
+
+            // Lado de las teselas en disposición Tiled/TiledMorton (potencia de 2, >= 32)
+            int tileSize;
+
+            // Posición de cada tesela en data; la tabla vive al final del mismo buffer
+            size_t* tileOffsets;
+
             // Flag para indicar si se está usando Buddy System
             bool usingBuddySystem;
-            
+
             // Sistema Buddy para gestión de memoria
             MemoryManagement::BuddySystem* buddySystem;
-            
-            // Buffer utilizado cuando se usa Buddy System
-            unsigned char* buddyBuffer;
-            
-            // Tamaño total del buffer
+
+            // Tamaño total del buffer en bytes
             size_t totalBufferSize;
-            
-            // Flag para activar/desactivar paralelización
-            static bool useParallelization;
-            
-            // Número de hilos a utilizar (por defecto 4)
-            static int numThreads;
 
-            Image();
-            ~Image();
+            // Número de imágenes que comparten el buffer (nullptr si no hay buffer).
+            // Las copias comparten los píxeles y sólo se duplican al escribir.
+            std::atomic<int>* references;
+
+            // Buffer externo adoptado o envuelto (adoptBuffer/wrapBuffer) y función que
+            // lo libera (nullptr si sólo está envuelto y su dueño es otro)
+            bool externalBuffer;
+            void (*externalRelease)(void*);
+
+            // Geometría con la que se reservó la memoria actual
+            int allocatedWidth;
+            int allocatedHeight;
+            int allocatedChannels;
+            PixelLayout allocatedLayout;
+            int allocatedTileSize;
+
+            ImageT();
+            ~ImageT();
 
-            // Constructor de copia y operador de asignación (prevenir fugas de memoria)
-            Image(const Image &other);
-            Image &operator=(const Image &other);
+            // Constructor de copia y operador de asignación: O(1), comparten el buffer
+            // con el original (copia al escribir, ver detach)
+            ImageT(const ImageT &other);
+            ImageT &operator=(const ImageT &other);
 
-            // Asigna memoria para la matriz tridimensional de píxeles usando el método seleccionado
+            // Constructor y asignación por movimiento: transfieren el buffer sin copiar píxeles
+            ImageT(ImageT &&other) noexcept;
+            ImageT &operator=(ImageT &&other) noexcept;
+
+            // Intercambia buffers, geometría y sistema de memoria con otra imagen
+            void swap(ImageT &other) noexcept;
+
+            // Asigna el buffer de píxeles usando el método seleccionado
             void allocateMemory(bool useBuddySystem = false);
 
-            // Libera la memoria asignada
+            // Reserva memoria sólo si la geometría o el modo de asignación cambiaron o
+            // el buffer está compartido; si no, reutiliza el buffer actual (sin
+            // inicializarlo a cero)
+            void ensureMemory(bool useBuddySystem = false);
+
+            // Suelta el buffer; la memoria se libera con la última imagen que lo comparte
             void freeMemory();
 
+            // Toma posesión de un buffer intercalado externo sin copiarlo (stride en
+            // muestras). release lo libera cuando la última imagen que lo comparte lo
+            // suelta. Si la geometría no cambia, los kernels escriben en él.
+            void adoptBuffer(T* buffer, int width, int height, int channels, size_t stride,
+                             void (*release)(void*));
+
+            // Igual que adoptBuffer pero sin tomar posesión: quien llama mantiene vivo
+            // el buffer mientras la imagen (o sus copias) lo usen
+            void wrapBuffer(T* buffer, int width, int height, int channels, size_t stride);
+
+            // Copia al escribir: si el buffer está compartido, pasa a tener una copia
+            // propia. Debe llamarse antes de modificar píxeles a través de data; las
+            // versiones no constantes de pixels(), row() y pixel() ya lo hacen, y
+            // ensureMemory también (sin copiar) para los destinos.
+            void detach();
+
+            bool isShared() const { return references && references->load(std::memory_order_acquire) > 1; }
+
+            // Vista sobre toda la imagen
+            ImageViewT<T> view() const;
+
+            // Vista sobre la región (x, y, w, h), sin copiar píxeles. Lanza
+            // std::out_of_range si la región no está dentro de la imagen.
+            ImageViewT<T> view(int x, int y, int w, int h) const;
+
+            // Imagen con la región (x, y, w, h). En disposición intercalada o planar
+            // es O(1): comparte el buffer con esta imagen (copia al escribir); en
+            // teselas la rejilla no encaja con la región y se copian los píxeles.
+            ImageT crop(int x, int y, int w, int h) const;
+
+            // Cambia la disposición en memoria conservando los píxeles. newTileSize
+            // (sólo en teselas) 0 conserva el lado de tesela actual
+            void setLayout(PixelLayout newLayout, int newTileSize = 0);
+
+            // Acceso al buffer, a una fila o a un píxel (disposición intercalada);
+            // sustituye al antiguo pixels[y][x]. Las versiones no constantes hacen
+            // detach() antes de devolver el puntero, así que escribir por él no cambia
+            // las copias que compartían el buffer; las constantes sólo permiten leer.
+            T* pixels()
+            {
+                if (isShared()) {
+                    detach();
+                }
+                return data;
+            }
+            const T* pixels() const { return data; }
+            T* row(int y) { return pixels() + y * stride; }
+            const T* row(int y) const { return data + y * stride; }
+            T* pixel(int x, int y) { return row(y) + x * channels; }
+            const T* pixel(int x, int y) const { return row(y) + x * channels; }
+
             // Devuelve información sobre la imagen
             std::string getInfo() const;
 
-            // Rota la imagen alrededor de su centro por un ángulo dado en grados
+            // Rota la imagen alrededor de su centro por un ángulo dado en grados. Los
+            // múltiplos de 90 son exactos (sin interpolar) y en los giros de 90 y 270
+            // el resultado tiene el ancho y el alto intercambiados.
             void rotateImage(float angleDegrees);
 
             // Escala la imagen por un factor dado
             void scaleImage(float factor);
 
+            // Variantes que escriben el resultado en dst. Si dst ya tiene la geometría
+            // del resultado se reutiliza su memoria, de modo que repetir la operación
+            // sobre imágenes del mismo tamaño no hace asignaciones en el heap. filter
+            // es el filtro de remuestreo de esa operación (los giros exactos de 90
+            // grados no lo usan).
+            void rotateTo(ImageT &dst, float angleDegrees,
+                          ResampleFilter filter = ImageBase::resampleFilter) const;
+            void scaleTo(ImageT &dst, float factor, ResampleFilter filter = ImageBase::resampleFilter) const;
+
+            // Volteo horizontal (espejo izquierda-derecha) y/o vertical, exacto
+            void flipTo(ImageT &dst, bool horizontal, bool vertical) const;
+
+            // Escalado con factores independientes en X e Y
+            void scaleTo(ImageT &dst, float factorX, float factorY,
+                         ResampleFilter filter = ImageBase::resampleFilter) const;
+
+            // Redimensiona a outWidth x outHeight (factores outWidth / width y
+            // outHeight / height)
+            void resizeTo(ImageT &dst, int outWidth, int outHeight,
+                          ResampleFilter filter = ImageBase::resampleFilter) const;
+
+            // Rotar y escalar en una sola pasada de remuestreo, directamente al tamaño
+            // final (sin imagen intermedia); equivale a rotateTo seguido de scaleTo
+            void rotateScaleTo(ImageT &dst, float angleDegrees, float factor,
+                               ResampleFilter filter = ImageBase::resampleFilter) const;
+
+            // Transformación afín arbitraria (de esta imagen a dst) sobre un lienzo de
+            // outWidth x outHeight; las zonas sin origen quedan en negro
+            void warpAffineTo(ImageT &dst, const AffineTransform &transform, int outWidth, int outHeight,
+                              ResampleFilter filter = ImageBase::resampleFilter) const;
+
             // Método auxiliar para la interpolación bilineal
-            unsigned char bilinearInterpolation(float x, float y, int channel);
-            
+            T bilinearInterpolation(float x, float y, int channel) const;
+
             // Optimización de la interpolación para procesar bloques de píxeles
-            void bilinearInterpolationBlock(float* srcX, float* srcY, int startX, int startY, 
-                                           int blockWidth, int blockHeight, unsigned char* output);
-            
+            void bilinearInterpolationBlock(float* srcX, float* srcY, int startX, int startY,
+                                           int blockWidth, int blockHeight, T* output) const;
+
             // Obtener estadísticas de memoria del Buddy System
             std::string getMemoryStats() const;
-            
-            // Establecer uso de paralelización y número de hilos
-            static void setParallelization(bool use, int threads = 4);
+
+        private:
+            void resizeTo(ImageT &dst, int outWidth, int outHeight, float factorX, float factorY,
+                          ResampleFilter filter) const;
+    };
+
+    typedef ImageT<uint8_t>  Image;
+    typedef ImageT<uint16_t> Image16;
+    typedef ImageT<float>    ImageF;
+
+    template <typename T>
+    inline void swap(ImageT<T> &a, ImageT<T> &b) noexcept
+    {
+        a.swap(b);
+    }
+
+    // Pirámide de reducciones a la mitad (mipmaps) de una imagen. Se construye una
+    // vez y sirve para sacar muchas miniaturas o reducciones fuertes: resizeTo
+    // parte del nivel más pequeño que mide al menos el doble del tamaño pedido, así
+    // que el promedio de área final lee pocos píxeles más que los del destino.
+    template <typename T>
+    class MipPyramidT
+    {
+        public:
+            // Nivel 0: la propia imagen (compartida, sin copia). Cada nivel siguiente
+            // promedia bloques de 2x2 del anterior, hasta que un lado llega a minSize
+            void build(const ImageT<T> &image, int minSize = 1);
+
+            int levelCount() const { return static_cast<int>(levels.size()); }
+            const ImageT<T> &level(int index) const { return levels[index]; }
+
+            // Redimensiona a outWidth x outHeight desde el nivel más cercano (promedio
+            // de área; aproxima el de resize sobre la imagen original)
+            void resizeTo(ImageT<T> &dst, int outWidth, int outHeight) const;
+
+        private:
+            std::vector<ImageT<T> > levels;
     };
 
+    typedef MipPyramidT<uint8_t>  MipPyramid;
+    typedef MipPyramidT<uint16_t> MipPyramid16;
+    typedef MipPyramidT<float>    MipPyramidF;
+
+    // Kernels sobre vistas: src y dst no deben solaparse. dst debe tener ya la
+    // geometría del resultado (mismo tamaño que src al rotar, src * factor al
+    // escalar, el lienzo elegido en warpAffine). src y dst son ambas planares o ninguna; intercalada y en teselas
+    // pueden combinarse libremente. Ambas pueden ser regiones (ImageViewT::region)
+    // de imágenes mayores; los píxeles de src fuera de la región no se leen. filter
+    // es el filtro de remuestreo (por defecto ImageBase::resampleFilter). Se
+    // instancian para cada tipo de muestra.
+    template <typename T>
+    void rotate(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees,
+                ResampleFilter filter = ImageBase::resampleFilter);
+    template <typename T>
+    void scale(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factor,
+               ResampleFilter filter = ImageBase::resampleFilter);
+
+    // Redimensionado separable (pasada horizontal y después vertical, con tablas
+    // de índices y pesos por columna y por fila): el píxel (x, y) de dst toma la
+    // muestra bilineal de src en (x / factorX, y / factorY). dst puede tener
+    // cualquier tamaño; scale es el caso factorX = factorY. Al reducir (factor < 1
+    // en algún eje) cada píxel de dst promedia el área de src que cubre. Con
+    // filter bicúbico o Lanczos-3 se usa ese filtro, ensanchado
+    // en 1 / factor al reducir. Con el vecino más cercano el píxel (x, y) de dst
+    // copia el de src que contiene ((x + 0.5) / factorX, (y + 0.5) / factorY): al
+    // ampliar por un entero cada píxel se repite exactamente factor x factor veces.
+    template <typename T>
+    void resize(const ImageViewT<T> &src, const ImageViewT<T> &dst, float factorX, float factorY,
+                ResampleFilter filter = ImageBase::resampleFilter);
+
+    // Giro exacto de quarterTurns * 90 grados en el sentido de rotate (90 lleva el
+    // píxel (x, y) a (src.height - 1 - y, x)), sin interpolar. En los giros impares
+    // dst mide src.height x src.width.
+    template <typename T>
+    void rotateRightAngle(const ImageViewT<T> &src, const ImageViewT<T> &dst, int quarterTurns);
+
+    // Volteo horizontal (espejo izquierda-derecha) y/o vertical; dst mide lo que src
+    template <typename T>
+    void flip(const ImageViewT<T> &src, const ImageViewT<T> &dst, bool horizontal, bool vertical);
+
+    // Rotación por tres cizallas (Paeth): desplaza las filas, después las columnas y
+    // otra vez las filas, cada vez con un filtro 1D (lineal, o filter si es
+    // bicúbico o Lanczos-3) y pesos únicos por fila o columna. Los ángulos
+    // fuera de [-45, 45] empiezan con un giro exacto. En zonas suaves coincide con
+    // la rotación directa (a +-2 en 8 bits); los detalles finos cambian algo porque
+    // tres interpolaciones 1D no equivalen a una 2D. Fuera de la imagen pone el color
+    // de BorderMode::Constant sea cual sea ImageBase::borderMode. Es lo que usa
+    // rotate con ImageBase::rotationEngine = RotationEngine::Shear y el borde
+    // constante; con los demás bordes, o con el vecino más cercano (que las cizallas
+    // harían lineal), rotate usa la rotación directa. Los dos intermedios, del tamaño
+    // de la imagen, son static thread_local: repetir la rotación no reserva memoria.
+    template <typename T>
+    void rotateShear(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees,
+                     ResampleFilter filter = ImageBase::resampleFilter);
+
+    // Rotación alrededor del centro de src seguida de escalado, compuestas en una
+    // única matriz inversa: dst mide src * factor y se remuestrea una sola vez
+    template <typename T>
+    void rotateScale(const ImageViewT<T> &src, const ImageViewT<T> &dst, float angleDegrees, float factor,
+                     ResampleFilter filter = ImageBase::resampleFilter);
+
+    // Motor común de las operaciones geométricas: cada píxel (x, y) de dst toma la
+    // muestra bilineal de src en transform.inverse() aplicada a (x, y). rotate,
+    // scale y rotateScale son casos particulares; dst puede tener cualquier tamaño.
+    // Con filter bicúbico o Lanczos-3 la muestra sale de ese filtro
+    // y con el vecino más cercano es el píxel de src más próximo a la posición.
+    // Los vecinos fuera de src siguen ImageBase::borderMode.
+    template <typename T>
+    void warpAffine(const ImageViewT<T> &src, const ImageViewT<T> &dst, const AffineTransform &transform,
+                    ResampleFilter filter = ImageBase::resampleFilter);
+
+    // Reducción a la mitad: cada píxel de dst (src / 2, redondeando hacia abajo)
+    // es el promedio del bloque de 2x2 correspondiente de src
+    template <typename T>
+    void halve(const ImageViewT<T> &src, const ImageViewT<T> &dst);
+
+    // Copia src en dst (misma geometría), convirtiendo entre disposiciones si difieren
+    template <typename T>
+    void convertLayout(const ImageViewT<T> &src, const ImageViewT<T> &dst);
+
+    // Muestra bilineal de un canal; fuera de la imagen devuelve 0 (negro)
+    template <typename T>
+    T bilinearSample(const ImageViewT<T> &src, float x, float y, int channel);
+
 } // namespace ImageProcessor
 
-#endif // IMAGE_PROCESSOR_H
\ No newline at end of file
+#endif // IMAGE_PROCESSOR_H
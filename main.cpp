@@ -2,9 +2,11 @@
 #include "image_processor.h"
 #include <cmath>
 #include <cstring>
+#include <exception>
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <algorithm>
 
 // Verificar si OpenMP está disponible
 #if defined(_OPENMP)
@@ -14,7 +16,11 @@
 void printUsage(const char *programName)
 {
     std::cout << "Uso: " << programName
-              << " entrada.jpg salida.jpg [-angulo grados] [-escalar factor] [-buddy] [-threads on|off]" << std::endl;
+              << " entrada.jpg salida.jpg [-angulo grados] [-escalar factor] [-buddy] [-threads on|off] [-repetir n] [-planar]"
+              << " [-teselas] [-morton] [-tesela n] [-profundidad 8|16|float] [-expandir] [-tamano ancho alto]"
+              << " [-filter nearest|bilinear|bicubic|lanczos] [-filtro-rotacion filtro] [-filtro-escalado filtro]"
+              << " [-rotacion directa|cizallas]"
+              << " [-borde constante|replicar|reflejar|mosaico] [-color-borde r g b]" << std::endl;
     std::cout << "Parámetros:" << std::endl;
     std::cout << "  entrada.jpg: archivo de imagen de entrada" << std::endl;
     std::cout << "  salida.jpg: archivo donde se guarda la imagen procesada" << std::endl;
@@ -22,147 +28,248 @@ void printUsage(const char *programName)
     std::cout << "  -escalar: define el factor de escalado (opcional)" << std::endl;
     std::cout << "  -buddy: activa el modo Buddy System (opcional)" << std::endl;
     std::cout << "  -threads: activa (on) o desactiva (off) paralelización con OpenMP (opcional)" << std::endl;
+    std::cout << "  -repetir: procesa la imagen n veces reutilizando los buffers intermedios (opcional)" << std::endl;
+    std::cout << "  -planar: procesa la imagen con un plano por canal en lugar de canales intercalados (opcional)" << std::endl;
+    std::cout << "  -teselas: procesa la imagen en teselas cuadradas ordenadas por filas (opcional)" << std::endl;
+    std::cout << "  -morton: procesa la imagen en teselas cuadradas en orden Z (opcional)" << std::endl;
+    std::cout << "  -tesela: lado de las teselas en píxeles, 32 o 64 (opcional, por defecto 32)" << std::endl;
+    std::cout << "  -profundidad: tipo de muestra durante el procesamiento: 8 bits, 16 bits (PNG de 16 bits)"
+              << " o float (opcional, por defecto 8)" << std::endl;
+    std::cout << "  -expandir: amplía el lienzo para conservar las esquinas de la imagen rotada (opcional)" << std::endl;
+    std::cout << "  -tamano: redimensiona a ancho x alto píxeles en lugar de usar -escalar (opcional)" << std::endl;
+    std::cout << "  -filter: filtro de remuestreo de la rotación y el escalado; nearest (vecino más cercano) es el más"
+              << " rápido (opcional, por defecto bilinear)" << std::endl;
+    std::cout << "  -filtro-rotacion, -filtro-escalado: filtro sólo de la rotación o sólo del escalado, con los"
+              << " mismos valores que -filter (opcional)" << std::endl;
+    std::cout << "  -rotacion: método de la rotación sin escalado, directa o por tres cizallas (opcional, por defecto"
+              << " directa)" << std::endl;
+    std::cout << "  -borde: valor de los vecinos fuera de la imagen al rotar: un color constante, el píxel del borde,"
+              << " el espejo o la imagen repetida (opcional, por defecto constante)" << std::endl;
+    std::cout << "  -color-borde: color del borde constante, de 0 a 255 por canal (opcional, por defecto negro)"
+              << std::endl;
 }
 
-int main(int argc, char *argv[])
+// Opciones de la línea de comandos
+struct Options
 {
-    if (argc < 3)
+    std::string inputFile;
+    std::string outputFile;
+    float rotationAngle;
+    float scaleFactor;
+    bool useBuddySystem;
+    bool useThreads;
+    int repetitions;
+    ImageProcessor::PixelLayout layout;
+    int tileSize;
+    bool expandCanvas;
+    int targetWidth;  // Tamaño final explícito (-tamano); 0 si no se pidió
+    int targetHeight;
+    ImageProcessor::ResampleFilter rotationFilter; // Filtro de la rotación (y de -expandir)
+    ImageProcessor::ResampleFilter scaleFilter;    // Filtro del escalado y de -tamano
+    ImageProcessor::RotationEngine rotationEngine;
+    ImageProcessor::BorderMode borderMode;
+    float borderColor[4]; // De 0 a 1 por canal (ver ImageBase::borderColor)
+};
+
+// Filtro de remuestreo por su nombre en la línea de comandos; false si no existe
+bool parseFilter(const char *name, ImageProcessor::ResampleFilter &filter)
+{
+    if (strcmp(name, "nearest") == 0)
     {
-        printUsage(argv[0]);
-        return 1;
+        filter = ImageProcessor::ResampleFilter::Nearest;
+    }
+    else if (strcmp(name, "bilinear") == 0)
+    {
+        filter = ImageProcessor::ResampleFilter::Bilinear;
     }
+    else if (strcmp(name, "bicubic") == 0)
+    {
+        filter = ImageProcessor::ResampleFilter::Bicubic;
+    }
+    else if (strcmp(name, "lanczos") == 0)
+    {
+        filter = ImageProcessor::ResampleFilter::Lanczos3;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
 
-    std::string inputFile  = argv[1];
-    std::string outputFile = argv[2];
+// Rotación y escalado en una sola pasada: sólo si ambos usan el mismo filtro
+bool combinedPass(const Options &options)
+{
+    return options.rotationAngle != 0.0f && options.scaleFactor != 1.0f && options.targetWidth == 0 &&
+           options.rotationFilter == options.scaleFilter;
+}
 
-    float rotationAngle  = 0.0f;
-    float scaleFactor    = 1.0f;
-    bool  useBuddySystem = false;
-    bool  useThreads     = true;
+// Aplica rotación y escalado escribiendo en imágenes de salida que se reutilizan
+// entre llamadas; devuelve la imagen que contiene el resultado final
+template <typename T>
+const ImageProcessor::ImageT<T> &applyTransforms(const ImageProcessor::ImageT<T> &source,
+                                                 ImageProcessor::ImageT<T> &rotated,
+                                                 ImageProcessor::ImageT<T> &scaled,
+                                                 const Options &options)
+{
+    const ImageProcessor::ImageT<T> *current = &source;
+    const float rotationAngle = options.rotationAngle;
+    const float scaleFactor = options.scaleFactor;
+    const bool expandCanvas = options.expandCanvas;
 
-    for (int i = 3; i < argc; i++)
+    // Lienzo ampliado: rotación y escalado como una transformación afín cuyo
+    // resultado contiene las cuatro esquinas
+    if (expandCanvas)
     {
-        if (strcmp(argv[i], "-angulo") == 0 && i + 1 < argc)
-        {
-            rotationAngle = static_cast<float>(atof(argv[i + 1]));
-            i++;
-        }
-        else if (strcmp(argv[i], "-escalar") == 0 && i + 1 < argc)
-        {
-            scaleFactor = static_cast<float>(atof(argv[i + 1]));
-            i++;
-        }
-        else if (strcmp(argv[i], "-buddy") == 0)
-        {
-            useBuddySystem = true;
-        }
-        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
-        {
-            if (strcmp(argv[i + 1], "on") == 0)
-            {
-                useThreads = true;
-            }
-            else if (strcmp(argv[i + 1], "off") == 0)
-            {
-                useThreads = false;
-            }
-            else
-            {
-                std::cerr << "Valor no válido para -threads. Use 'on' u 'off'." << std::endl;
-                return 1;
-            }
-            i++;
-        }
+        int outWidth, outHeight;
+        ImageProcessor::AffineTransform transform =
+            ImageProcessor::AffineTransform::rotation(rotationAngle, source.width / 2.0f, source.height / 2.0f)
+                .then(ImageProcessor::AffineTransform::scaling(scaleFactor, scaleFactor))
+                .expandCanvas(source.width, source.height, outWidth, outHeight);
+        source.warpAffineTo(scaled, transform, outWidth, outHeight, options.rotationFilter);
+        return scaled;
     }
 
-    // Configurar paralelización basado en los argumentos
-    ImageProcessor::Image::setParallelization(useThreads, 4);
+    // Con ambas operaciones se remuestrea una sola vez directamente al tamaño final
+    if (combinedPass(options))
+    {
+        source.rotateScaleTo(scaled, rotationAngle, scaleFactor, options.rotationFilter);
+        return scaled;
+    }
 
-    if (!FileIO::isValidImageFile(inputFile))
+    if (rotationAngle != 0.0f)
     {
-        std::cerr << "Error: El archivo " << inputFile << " no existe o no es una imagen válida." << std::endl;
-        return 1;
+        current->rotateTo(rotated, rotationAngle, options.rotationFilter);
+        current = &rotated;
+    }
+
+    if (options.targetWidth > 0)
+    {
+        current->resizeTo(scaled, options.targetWidth, options.targetHeight, options.scaleFilter);
+        current = &scaled;
+    }
+    else if (scaleFactor != 1.0f)
+    {
+        current->scaleTo(scaled, scaleFactor, options.scaleFilter);
+        current = &scaled;
     }
 
-    ImageProcessor::Image image;
+    return *current;
+}
+
+// Carga, procesa y guarda la imagen con muestras de tipo T
+template <typename T>
+int processImage(const Options &options)
+{
+    ImageProcessor::ImageT<T> image;
     size_t memoryUsedNoBuddy = 0, memoryUsedBuddy = 0;
     size_t durationNoBuddy = 0, durationBuddy = 0;
 
-    std::cout << "Cargando imagen: " << inputFile << std::endl;
-    if (!FileIO::loadImage(inputFile, image, useBuddySystem))
+    std::cout << "Cargando imagen: " << options.inputFile << std::endl;
+    image.tileSize = options.tileSize;
+    if (!FileIO::loadImage(options.inputFile, image, options.useBuddySystem, options.layout))
     {
         std::cerr << "Error al cargar la imagen." << std::endl;
         return 1;
     }
 
     std::cout << "=== PROCESAMIENTO DE IMAGEN ===" << std::endl;
-    std::cout << "Archivo de entrada: " << inputFile << std::endl;
-    std::cout << "Archivo de salida: " << outputFile << std::endl;
-    std::cout << "Modo de asignación de memoria: " << (useBuddySystem ? "Buddy System" : "Convencional") << std::endl;
-    std::cout << "Paralelización OpenMP: " << (useThreads ? "Activada" : "Desactivada") << std::endl;
+    std::cout << "Archivo de entrada: " << options.inputFile << std::endl;
+    std::cout << "Archivo de salida: " << options.outputFile << std::endl;
+    std::cout << "Modo de asignación de memoria: " << (options.useBuddySystem ? "Buddy System" : "Convencional") << std::endl;
+    std::cout << "Paralelización OpenMP: " << (options.useThreads ? "Activada" : "Desactivada") << std::endl;
+    if (options.rotationFilter == options.scaleFilter)
+    {
+        std::cout << "Filtro de remuestreo: " << ImageProcessor::filterName(options.rotationFilter) << std::endl;
+    }
+    else
+    {
+        std::cout << "Filtro de remuestreo: " << ImageProcessor::filterName(options.rotationFilter) << " al rotar, "
+                  << ImageProcessor::filterName(options.scaleFilter) << " al escalar" << std::endl;
+    }
+    std::cout << "Rotación: " << ImageProcessor::engineName(options.rotationEngine) << std::endl;
+    std::cout << "Borde: " << ImageProcessor::borderName(options.borderMode) << std::endl;
     std::cout << "------------------------" << std::endl;
     std::cout << "Dimensiones originales: " << image.width << " x " << image.height << std::endl;
     std::cout << image.getInfo() << std::endl;
     std::cout << "------------------------" << std::endl;
 
+    if (options.rotationAngle != 0.0f)
+    {
+        std::cout << "Ángulo de rotación: " << options.rotationAngle << " grados" << std::endl;
+    }
+
+    if (options.targetWidth > 0)
+    {
+        std::cout << "Tamaño final: " << options.targetWidth << " x " << options.targetHeight << std::endl;
+    }
+    else if (options.scaleFactor != 1.0f)
+    {
+        std::cout << "Factor de escalado: " << options.scaleFactor << std::endl;
+    }
+
+    if (combinedPass(options))
+    {
+        std::cout << "Rotación y escalado combinados en una sola pasada" << std::endl;
+    }
+
+    // Imágenes intermedias: a partir de la segunda repetición se reutiliza su memoria
+    ImageProcessor::ImageT<T> rotatedImage, scaledImage;
+    const ImageProcessor::ImageT<T> *result = &image;
+    size_t firstPassDuration = 0;
+
     // Si estamos usando Buddy System, medimos su tiempo directamente
     // Si no, medimos el tiempo sin Buddy System
-    if (useBuddySystem && image.usingBuddySystem && image.buddySystem) {
-        // Medir tiempo con Buddy System
-        auto startTimeBuddy = std::chrono::high_resolution_clock::now();
-        
-        if (rotationAngle != 0.0f)
-        {
-            std::cout << "Ángulo de rotación: " << rotationAngle << " grados" << std::endl;
-            image.rotateImage(rotationAngle);
-        }
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    for (int r = 0; r < options.repetitions; r++)
+    {
+        result = &applyTransforms(image, rotatedImage, scaledImage, options);
 
-        if (scaleFactor != 1.0f)
+        if (r == 0)
         {
-            std::cout << "Factor de escalado: " << scaleFactor << std::endl;
-            image.scaleImage(scaleFactor);
+            firstPassDuration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::high_resolution_clock::now() - startTime).count();
         }
-        
-        auto endTimeBuddy = std::chrono::high_resolution_clock::now();
-        durationBuddy = std::chrono::duration_cast<std::chrono::milliseconds>(endTimeBuddy - startTimeBuddy).count();
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    size_t totalDuration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+    const ImageProcessor::ImageT<T> &output = *result;
+
+    if (options.useBuddySystem && output.usingBuddySystem && output.buddySystem) {
+        // Medir tiempo con Buddy System
+        durationBuddy = firstPassDuration;
         
         // Estimar el tiempo sin Buddy System
         durationNoBuddy = durationBuddy * 2; // Asumimos que es aproximadamente el doble
         
-        auto stats = image.buddySystem->getStats();
+        auto stats = output.buddySystem->getStats();
         memoryUsedBuddy = stats.usedMemory;
-        memoryUsedNoBuddy = image.totalBufferSize + (image.width * image.height * sizeof(unsigned char*) * 2);
+        memoryUsedNoBuddy = output.totalBufferSize;
     } else {
         // Medir tiempo sin Buddy System
-        auto startTimeNoBuddy = std::chrono::high_resolution_clock::now();
-        
-        if (rotationAngle != 0.0f)
-        {
-            std::cout << "Ángulo de rotación: " << rotationAngle << " grados" << std::endl;
-            image.rotateImage(rotationAngle);
-        }
-
-        if (scaleFactor != 1.0f)
-        {
-            std::cout << "Factor de escalado: " << scaleFactor << std::endl;
-            image.scaleImage(scaleFactor);
-        }
-        
-        auto endTimeNoBuddy = std::chrono::high_resolution_clock::now();
-        durationNoBuddy = std::chrono::duration_cast<std::chrono::milliseconds>(endTimeNoBuddy - startTimeNoBuddy).count();
+        durationNoBuddy = firstPassDuration;
         
         // No estimamos el tiempo con Buddy System si no lo estamos usando
         
-        memoryUsedNoBuddy = image.totalBufferSize + (image.width * image.height * sizeof(unsigned char*) * 2);
+        memoryUsedNoBuddy = output.totalBufferSize;
     }
 
-    std::cout << "Dimensiones finales: " << image.width << " x " << image.height << std::endl;
+    std::cout << "Dimensiones finales: " << output.width << " x " << output.height << std::endl;
+
+    if (options.repetitions > 1)
+    {
+        // Las repeticiones posteriores a la primera reutilizan los buffers ya reservados
+        std::cout << "Régimen estable: " << (totalDuration - firstPassDuration) / (double)(options.repetitions - 1)
+                  << " ms por repetición (" << options.repetitions - 1 << " repeticiones)" << std::endl;
+    }
 
     std::cout << "----------------------- " << std::endl;
 
     std::cout << "TIEMPO DE PROCESAMIENTO:" << std::endl;
     std::cout << "- Sin Buddy System: " << durationNoBuddy << " ms" << std::endl;
-    if (useBuddySystem) {
+    if (options.useBuddySystem) {
         std::cout << "- Con Buddy System: " << durationBuddy << " ms" << std::endl;
     }
     
@@ -170,19 +277,263 @@ int main(int argc, char *argv[])
     
     std::cout << "MEMORIA UTILIZADA:" << std::endl;
     std::cout << "- Sin Buddy System: " << (memoryUsedNoBuddy / (1024.0f * 1024.0f)) << " MB" << std::endl;
-    if (useBuddySystem) {
+    if (options.useBuddySystem) {
         std::cout << "- Con Buddy System: " << (memoryUsedBuddy / (1024.0f * 1024.0f)) << " MB" << std::endl;
     }
 
     std::cout << "----------------------- " << std::endl;
 
-    std::cout << "Guardando imagen en: " << outputFile << std::endl;
-    if (!FileIO::saveImage(outputFile, image))
+    std::cout << "Guardando imagen en: " << options.outputFile << std::endl;
+    if (!FileIO::saveImage(options.outputFile, output))
     {
         std::cerr << "Error al guardar la imagen." << std::endl;
         return 1;
     }
 
-    std::cout << "[INFO] Imagen guardada correctamente en " << outputFile << std::endl;
+    std::cout << "[INFO] Imagen guardada correctamente en " << options.outputFile << std::endl;
+
+    // Memoria usada por stb al decodificar/codificar, servida desde el pool de códecs
+    auto codecStats = FileIO::getCodecPoolStats();
+    std::cout << "Pool de códecs (stb): pico " << (codecStats.peakMemory / (1024.0f * 1024.0f))
+              << " MB de " << (codecStats.reservedMemory / (1024.0f * 1024.0f)) << " MB reservados ("
+              << (codecStats.residentMemory / (1024.0f * 1024.0f)) << " MB residentes)" << std::endl;
     return 0;
-}
\ No newline at end of file
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    Options options;
+    options.inputFile      = argv[1];
+    options.outputFile     = argv[2];
+    options.rotationAngle  = 0.0f;
+    options.scaleFactor    = 1.0f;
+    options.useBuddySystem = false;
+    options.useThreads     = true;
+    options.repetitions    = 1;
+    options.layout         = ImageProcessor::PixelLayout::Interleaved;
+    options.tileSize       = ImageProcessor::DEFAULT_TILE_SIZE;
+    options.expandCanvas   = false;
+    options.targetWidth    = 0;
+    options.targetHeight   = 0;
+    options.rotationFilter = ImageProcessor::ResampleFilter::Bilinear;
+    options.scaleFilter    = ImageProcessor::ResampleFilter::Bilinear;
+    options.rotationEngine = ImageProcessor::RotationEngine::Direct;
+    options.borderMode     = ImageProcessor::BorderMode::Constant;
+    std::fill(options.borderColor, options.borderColor + 4, 0.0f);
+    std::string depth      = "8";
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-angulo") == 0 && i + 1 < argc)
+        {
+            options.rotationAngle = static_cast<float>(atof(argv[i + 1]));
+            i++;
+        }
+        else if (strcmp(argv[i], "-escalar") == 0 && i + 1 < argc)
+        {
+            options.scaleFactor = static_cast<float>(atof(argv[i + 1]));
+            if (!std::isfinite(options.scaleFactor) || options.scaleFactor <= 0.0f)
+            {
+                std::cerr << "Valor no válido para -escalar. Use un número mayor que 0." << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-repetir") == 0 && i + 1 < argc)
+        {
+            options.repetitions = std::max(1, atoi(argv[i + 1]));
+            i++;
+        }
+        else if (strcmp(argv[i], "-planar") == 0)
+        {
+            options.layout = ImageProcessor::PixelLayout::Planar;
+        }
+        else if (strcmp(argv[i], "-teselas") == 0)
+        {
+            options.layout = ImageProcessor::PixelLayout::Tiled;
+        }
+        else if (strcmp(argv[i], "-morton") == 0)
+        {
+            options.layout = ImageProcessor::PixelLayout::TiledMorton;
+        }
+        else if (strcmp(argv[i], "-tesela") == 0 && i + 1 < argc)
+        {
+            options.tileSize = atoi(argv[i + 1]);
+            if (options.tileSize != 32 && options.tileSize != 64)
+            {
+                std::cerr << "Valor no válido para -tesela. Use 32 o 64." << std::endl;
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-profundidad") == 0 && i + 1 < argc)
+        {
+            depth = argv[i + 1];
+            if (depth != "8" && depth != "16" && depth != "float")
+            {
+                std::cerr << "Valor no válido para -profundidad. Use 8, 16 o float." << std::endl;
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-expandir") == 0)
+        {
+            options.expandCanvas = true;
+        }
+        else if (strcmp(argv[i], "-tamano") == 0 && i + 2 < argc)
+        {
+            options.targetWidth  = atoi(argv[i + 1]);
+            options.targetHeight = atoi(argv[i + 2]);
+            if (options.targetWidth <= 0 || options.targetHeight <= 0)
+            {
+                std::cerr << "Valor no válido para -tamano. Use dos enteros positivos (ancho alto)." << std::endl;
+                return 1;
+            }
+            i += 2;
+        }
+        else if ((strcmp(argv[i], "-filter") == 0 || strcmp(argv[i], "-filtro-rotacion") == 0 ||
+                  strcmp(argv[i], "-filtro-escalado") == 0) && i + 1 < argc)
+        {
+            ImageProcessor::ResampleFilter filter;
+            if (!parseFilter(argv[i + 1], filter))
+            {
+                std::cerr << "Valor no válido para " << argv[i] << ". Use nearest, bilinear, bicubic o lanczos."
+                          << std::endl;
+                return 1;
+            }
+            if (strcmp(argv[i], "-filtro-escalado") != 0)
+            {
+                options.rotationFilter = filter;
+            }
+            if (strcmp(argv[i], "-filtro-rotacion") != 0)
+            {
+                options.scaleFilter = filter;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-rotacion") == 0 && i + 1 < argc)
+        {
+            if (strcmp(argv[i + 1], "directa") == 0)
+            {
+                options.rotationEngine = ImageProcessor::RotationEngine::Direct;
+            }
+            else if (strcmp(argv[i + 1], "cizallas") == 0)
+            {
+                options.rotationEngine = ImageProcessor::RotationEngine::Shear;
+            }
+            else
+            {
+                std::cerr << "Valor no válido para -rotacion. Use directa o cizallas." << std::endl;
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-borde") == 0 && i + 1 < argc)
+        {
+            if (strcmp(argv[i + 1], "constante") == 0)
+            {
+                options.borderMode = ImageProcessor::BorderMode::Constant;
+            }
+            else if (strcmp(argv[i + 1], "replicar") == 0)
+            {
+                options.borderMode = ImageProcessor::BorderMode::Clamp;
+            }
+            else if (strcmp(argv[i + 1], "reflejar") == 0)
+            {
+                options.borderMode = ImageProcessor::BorderMode::Reflect;
+            }
+            else if (strcmp(argv[i + 1], "mosaico") == 0)
+            {
+                options.borderMode = ImageProcessor::BorderMode::Wrap;
+            }
+            else
+            {
+                std::cerr << "Valor no válido para -borde. Use constante, replicar, reflejar o mosaico." << std::endl;
+                return 1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "-color-borde") == 0 && i + 3 < argc)
+        {
+            // Color opaco: el alfa de las imágenes RGBA queda a 255
+            for (int c = 0; c < 3; c++)
+            {
+                const int value = atoi(argv[i + 1 + c]);
+                if (value < 0 || value > 255)
+                {
+                    std::cerr << "Valor no válido para -color-borde. Use tres enteros de 0 a 255 (r g b)." << std::endl;
+                    return 1;
+                }
+                options.borderColor[c] = value / 255.0f;
+            }
+            options.borderColor[3] = 1.0f;
+            i += 3;
+        }
+        else if (strcmp(argv[i], "-buddy") == 0)
+        {
+            options.useBuddySystem = true;
+        }
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc)
+        {
+            if (strcmp(argv[i + 1], "on") == 0)
+            {
+                options.useThreads = true;
+            }
+            else if (strcmp(argv[i + 1], "off") == 0)
+            {
+                options.useThreads = false;
+            }
+            else
+            {
+                std::cerr << "Valor no válido para -threads. Use 'on' u 'off'." << std::endl;
+                return 1;
+            }
+            i++;
+        }
+    }
+
+    if (options.expandCanvas && options.targetWidth > 0)
+    {
+        std::cerr << "-tamano no se puede combinar con -expandir." << std::endl;
+        return 1;
+    }
+
+    // Configurar paralelización basado en los argumentos
+    ImageProcessor::Image::setParallelization(options.useThreads, 4);
+    ImageProcessor::ImageBase::rotationEngine = options.rotationEngine;
+    ImageProcessor::ImageBase::borderMode = options.borderMode;
+    std::copy(options.borderColor, options.borderColor + 4, ImageProcessor::ImageBase::borderColor);
+
+    if (!FileIO::isValidImageFile(options.inputFile))
+    {
+        std::cerr << "Error: El archivo " << options.inputFile << " no existe o no es una imagen válida." << std::endl;
+        return 1;
+    }
+
+    // Los errores de las operaciones (matrices singulares, memoria agotada...)
+    // terminan el programa con un mensaje en lugar de abortar
+    try
+    {
+        if (depth == "16")
+        {
+            return processImage<uint16_t>(options);
+        }
+        if (depth == "float")
+        {
+            return processImage<float>(options);
+        }
+        return processImage<uint8_t>(options);
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << "Error al procesar la imagen: " << error.what() << std::endl;
+        return 1;
+    }
+}
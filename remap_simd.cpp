@@ -0,0 +1,228 @@
+#include "remap_simd.h"
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define REMAP_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace RemapSimd
+{
+#if defined(REMAP_SIMD_X86)
+
+    // Copia escalar de un píxel (resto de los bloques y de las filas)
+    static inline void copyPixel(const uint8_t* in, uint8_t* out, int channels)
+    {
+        for (int c = 0; c < channels; c++) {
+            out[c] = in[c];
+        }
+    }
+
+    // Lectura y escritura de exactamente 4 píxeles (4 * C bytes) en un registro: sin
+    // tocar bytes fuera del tramo, que pueden ser de otra fila o de otro hilo
+    template <int C>
+    __attribute__((target("sse4.1")))
+    static inline __m128i loadPixels(const uint8_t* p)
+    {
+        int32_t word;
+        switch (C) {
+            case 1:
+                memcpy(&word, p, 4);
+                return _mm_cvtsi32_si128(word);
+            case 3:
+                // 8 + 4 bytes directos a registro, sin pasar por la pila
+                memcpy(&word, p + 8, 4);
+                return _mm_insert_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)), word, 2);
+            default:
+                return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        }
+    }
+
+    template <int C>
+    __attribute__((target("sse4.1")))
+    static inline void storePixels(uint8_t* p, __m128i v)
+    {
+        int32_t word;
+        switch (C) {
+            case 1:
+                word = _mm_cvtsi128_si32(v);
+                memcpy(p, &word, 4);
+                break;
+            case 3:
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(p), v);
+                word = _mm_extract_epi32(v, 2);
+                memcpy(p + 8, &word, 4);
+                break;
+            default:
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+                break;
+        }
+    }
+
+    // Máscara de pshufb que lleva los 4 píxeles leídos (en orden inverso si reverse)
+    // a una palabra de 32 bits cada uno. Con C = 1 los cuatro registros de una
+    // tesela se juntan antes en uno (palabra j = columna j) y la máscara ya traspone.
+    template <int C>
+    static inline void expandMask(bool reverse, int8_t mask[16])
+    {
+        for (int i = 0; i < 16; i++) {
+            const int word = i / 4, byte = i % 4;
+            if (C == 1) {
+                mask[i] = (int8_t)(byte * 4 + (reverse ? 3 - word : word));
+            } else {
+                const int pixel = reverse ? 3 - word : word;
+                mask[i] = (byte < C) ? (int8_t)(pixel * C + byte) : (int8_t)-128;
+            }
+        }
+    }
+
+    template <int C>
+    __attribute__((target("sse4.1")))
+    static void transposeKernel(const uint8_t* src, ptrdiff_t stepX, ptrdiff_t stepY,
+                                uint8_t* dst, size_t dstStride, int width, int height)
+    {
+        // Las columnas de dst se leen de menor a mayor dirección en src; si stepY es
+        // negativo llegan al revés y la máscara de expansión las reordena
+        const bool reverse = stepY < 0;
+        int8_t expand[16], pack[16];
+        expandMask<C>(reverse, expand);
+        for (int i = 0; i < 16; i++) {
+            pack[i] = (i < 4 * C) ? (int8_t)(i / C * 4 + i % C) : (int8_t)-128;
+        }
+        const __m128i expandBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expand));
+        const __m128i packBytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pack));
+
+        int y = 0;
+        for (; y + 4 <= height; y += 4) {
+            const uint8_t* column = src + y * stepY + (reverse ? 3 * stepY : 0);
+            int x = 0;
+            for (; x + 4 <= width; x += 4) {
+                // v[j]: columna x + j de dst, filas y..y+3 (4 píxeles contiguos en src)
+                __m128i v[4];
+                for (int j = 0; j < 4; j++) {
+                    v[j] = loadPixels<C>(column + (x + j) * stepX);
+                }
+
+                __m128i rows[4];
+                if (C == 1) {
+                    // Un byte por píxel: las cuatro columnas caben en un registro
+                    __m128i all = _mm_or_si128(_mm_or_si128(v[0], _mm_slli_si128(v[1], 4)),
+                                               _mm_or_si128(_mm_slli_si128(v[2], 8), _mm_slli_si128(v[3], 12)));
+                    all = _mm_shuffle_epi8(all, expandBytes);
+                    rows[0] = all;
+                    rows[1] = _mm_srli_si128(all, 4);
+                    rows[2] = _mm_srli_si128(all, 8);
+                    rows[3] = _mm_srli_si128(all, 12);
+                } else {
+                    for (int j = 0; j < 4; j++) {
+                        v[j] = _mm_shuffle_epi8(v[j], expandBytes);
+                    }
+                    // Trasposición 4x4 de palabras de 32 bits (un píxel por palabra)
+                    const __m128i t0 = _mm_unpacklo_epi32(v[0], v[1]);
+                    const __m128i t1 = _mm_unpacklo_epi32(v[2], v[3]);
+                    const __m128i t2 = _mm_unpackhi_epi32(v[0], v[1]);
+                    const __m128i t3 = _mm_unpackhi_epi32(v[2], v[3]);
+                    rows[0] = _mm_unpacklo_epi64(t0, t1);
+                    rows[1] = _mm_unpackhi_epi64(t0, t1);
+                    rows[2] = _mm_unpacklo_epi64(t2, t3);
+                    rows[3] = _mm_unpackhi_epi64(t2, t3);
+                    if (C == 3) {
+                        for (int k = 0; k < 4; k++) {
+                            rows[k] = _mm_shuffle_epi8(rows[k], packBytes);
+                        }
+                    }
+                }
+
+                for (int k = 0; k < 4; k++) {
+                    storePixels<C>(dst + (y + k) * dstStride + x * C, rows[k]);
+                }
+            }
+
+            // Columnas sobrantes de estas cuatro filas
+            for (; x < width; x++) {
+                for (int k = 0; k < 4; k++) {
+                    copyPixel(src + x * stepX + (y + k) * stepY, dst + (y + k) * dstStride + x * C, C);
+                }
+            }
+        }
+
+        // Filas sobrantes
+        for (; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                copyPixel(src + x * stepX + y * stepY, dst + y * dstStride + x * C, C);
+            }
+        }
+    }
+
+    template <int C>
+    __attribute__((target("sse4.1")))
+    static void reverseKernel(const uint8_t* in, uint8_t* out, int n)
+    {
+        // Un registro de 16 bytes por paso: 16 píxeles de 1 byte o 4 de 3 o 4 bytes
+        const int step = (C == 1) ? 16 : 4;
+        int8_t mask[16];
+        for (int i = 0; i < 16; i++) {
+            if (C == 1) {
+                mask[i] = (int8_t)(15 - i);
+            } else {
+                mask[i] = (i < 4 * C) ? (int8_t)((3 - i / C) * C + i % C) : (int8_t)-128;
+            }
+        }
+        const __m128i reverseMask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+
+        int i = 0;
+        for (; i + step <= n; i += step) {
+            const uint8_t* p = in + (n - step - i) * C;
+            __m128i v = (C == 1) ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) : loadPixels<C>(p);
+            v = _mm_shuffle_epi8(v, reverseMask);
+            if (C == 1) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+            } else {
+                storePixels<C>(out + i * C, v);
+            }
+        }
+
+        for (; i < n; i++) {
+            copyPixel(in + (n - 1 - i) * C, out + i * C, C);
+        }
+    }
+
+    bool transposeBlock(const uint8_t* src, ptrdiff_t stepX, ptrdiff_t stepY, int channels,
+                        uint8_t* dst, size_t dstStride, int width, int height)
+    {
+        if (stepY != channels && stepY != -channels) {
+            return false;
+        }
+
+        switch (channels) {
+            case 1:  transposeKernel<1>(src, stepX, stepY, dst, dstStride, width, height); return true;
+            case 3:  transposeKernel<3>(src, stepX, stepY, dst, dstStride, width, height); return true;
+            case 4:  transposeKernel<4>(src, stepX, stepY, dst, dstStride, width, height); return true;
+            default: return false;
+        }
+    }
+
+    bool reverseRow(const uint8_t* in, int channels, uint8_t* out, int n)
+    {
+        switch (channels) {
+            case 1:  reverseKernel<1>(in, out, n); return true;
+            case 3:  reverseKernel<3>(in, out, n); return true;
+            case 4:  reverseKernel<4>(in, out, n); return true;
+            default: return false;
+        }
+    }
+
+#else
+
+    bool transposeBlock(const uint8_t*, ptrdiff_t, ptrdiff_t, int, uint8_t*, size_t, int, int)
+    {
+        return false;
+    }
+
+    bool reverseRow(const uint8_t*, int, uint8_t*, int)
+    {
+        return false;
+    }
+
+#endif
+} // namespace RemapSimd
@@ -0,0 +1,25 @@
+#ifndef REMAP_SIMD_H
+#define REMAP_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Kernels vectoriales (SSE4.1) de las copias exactas de píxeles de 8 bits: giros
+// de 90 grados (trasposición por bloques de 4x4 píxeles) y volteos (filas en
+// orden inverso). El llamador comprueba antes que la CPU tiene SSE4.1.
+namespace RemapSimd
+{
+    // Copia un bloque de width x height píxeles intercalados (channels 1, 3 o 4):
+    // el píxel (x, y) de dst, en dst + y * dstStride + x * channels, es el de src
+    // + x * stepX + y * stepY (desplazamientos en bytes). stepY debe ser channels o
+    // -channels, así que cada columna de dst es un tramo de fila de src. Devuelve
+    // false si no hay versión vectorial (el llamador copia en escalar).
+    bool transposeBlock(const uint8_t* src, ptrdiff_t stepX, ptrdiff_t stepY, int channels,
+                        uint8_t* dst, size_t dstStride, int width, int height);
+
+    // Copia n píxeles intercalados en orden inverso: el píxel i de out es el
+    // n - 1 - i de in. Devuelve false si no hay versión vectorial.
+    bool reverseRow(const uint8_t* in, int channels, uint8_t* out, int n);
+} // namespace RemapSimd
+
+#endif // REMAP_SIMD_H
@@ -0,0 +1,163 @@
+// Garantía de régimen estable sin reservas: tras una pasada de calentamiento,
+// repetir las transformaciones sobre imágenes de la misma geometría no debe
+// reservar memoria del heap. malloc y compañía y operator new se interceptan y
+// cuentan mientras se repiten las operaciones; cualquier reserva hace fallar la
+// prueba. Cubre también el motor de tres cizallas (ver rotateShear).
+
+#include "test_utils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace ImageProcessor;
+
+// Contador de reservas mientras counting está activo
+static bool counting = false;
+static long allocations = 0;
+
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* pointer, size_t size);
+extern "C" void* __libc_memalign(size_t alignment, size_t size);
+
+static inline void countAllocation()
+{
+    if (counting) {
+        allocations++;
+    }
+}
+
+extern "C" void* malloc(size_t size)
+{
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size)
+{
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* pointer, size_t size)
+{
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" int posix_memalign(void** pointer, size_t alignment, size_t size)
+{
+    countAllocation();
+    *pointer = __libc_memalign(alignment, size);
+    return *pointer ? 0 : 12; // ENOMEM
+}
+
+extern "C" void* aligned_alloc(size_t alignment, size_t size)
+{
+    countAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+void* operator new(size_t size)
+{
+    countAllocation();
+    void* pointer = __libc_malloc(size);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+
+// Reservas de repetitions pasadas de operation después de dos de calentamiento
+static long steadyAllocations(const std::function<void()> &operation, int repetitions)
+{
+    operation();
+    operation();
+
+    allocations = 0;
+    counting = true;
+    for (int r = 0; r < repetitions; r++) {
+        operation();
+    }
+    counting = false;
+    return allocations;
+}
+
+int main()
+{
+    const PixelLayout layouts[] = {PixelLayout::Interleaved, PixelLayout::Planar, PixelLayout::Tiled};
+    const char *layoutNames[] = {"intercalada", "planar", "teselas"};
+    const ResampleFilter filters[] = {ResampleFilter::Nearest, ResampleFilter::Bilinear, ResampleFilter::Bicubic,
+                                      ResampleFilter::Lanczos3};
+
+    for (int buddy = 0; buddy < 2; buddy++) {
+        for (int l = 0; l < 3; l++) {
+            // Preparación (fuera del recuento): origen y destinos reutilizados
+            Image source, rotated, scaled, warped;
+            TestUtils::makeSmoothImage(source, 333, 211, 3, buddy != 0);
+            source.setLayout(layouts[l]);
+
+            for (ResampleFilter filter : filters) {
+                struct Case
+                {
+                    const char *name;
+                    std::function<void()> operation;
+                } cases[] = {
+                    {"rotar 25", [&]() { source.rotateTo(rotated, 25.0f, filter); }},
+                    {"rotar 90", [&]() { source.rotateTo(rotated, 90.0f, filter); }},
+                    {"escalar 1.7", [&]() { source.scaleTo(scaled, 1.7f, filter); }},
+                    {"escalar 0.6", [&]() { source.scaleTo(scaled, 0.6f, filter); }},
+                    {"escalar 2", [&]() { source.scaleTo(scaled, 2.0f, filter); }},
+                    {"tamaño 150x260", [&]() { source.resizeTo(scaled, 150, 260, filter); }},
+                    {"rotar y escalar", [&]() { source.rotateScaleTo(warped, 30.0f, 0.8f, filter); }},
+                };
+
+                for (const Case &test : cases) {
+                    const long count = steadyAllocations(test.operation, 5);
+                    if (count != 0) {
+                        TestUtils::fail("%s (%s, %s, %s): %ld reservas en régimen estable", test.name,
+                                        layoutNames[l], filterName(filter), buddy ? "buddy" : "convencional", count);
+                    }
+                }
+            }
+
+            // Modos de borde del warp
+            ImageBase::borderMode = BorderMode::Reflect;
+            const long count = steadyAllocations([&]() { source.rotateTo(rotated, 25.0f); }, 5);
+            ImageBase::borderMode = BorderMode::Constant;
+            if (count != 0) {
+                TestUtils::fail("rotar 25 con borde reflejado (%s, %s): %ld reservas en régimen estable",
+                                layoutNames[l], buddy ? "buddy" : "convencional", count);
+            }
+
+            // Rotación por tres cizallas, con y sin giro exacto previo
+            ImageBase::rotationEngine = RotationEngine::Shear;
+            for (ResampleFilter filter : filters) {
+                for (float angle : {25.0f, 200.0f}) {
+                    const long shearCount = steadyAllocations([&]() { source.rotateTo(rotated, angle, filter); }, 5);
+                    if (shearCount != 0) {
+                        TestUtils::fail("rotar %g con cizallas (%s, %s, %s): %ld reservas en régimen estable",
+                                        angle, layoutNames[l], filterName(filter), buddy ? "buddy" : "convencional",
+                                        shearCount);
+                    }
+                }
+            }
+            ImageBase::rotationEngine = RotationEngine::Direct;
+        }
+    }
+
+    return TestUtils::report("test_allocations");
+}
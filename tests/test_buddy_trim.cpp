@@ -0,0 +1,73 @@
+// Recuento de memoria residente del Buddy System tras trim: las páginas devueltas
+// con MADV_DONTNEED dejan de ser residentes, mientras que las marcadas con
+// MADV_FREE (trim con lazyFree) siguen contando como residentes y se informan en
+// lazyFreeMemory hasta que un bloque vuelve a usarlas o un trim normal las libera.
+// La reserva caliente de trim se cuenta en bytes, no en bloques libres enteros.
+
+#include "buddy_system.h"
+#include "test_utils.h"
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+
+using MemoryManagement::BuddySystem;
+
+static void check(bool condition, const char *description, const BuddySystem::MemoryStats &stats)
+{
+    if (!condition) {
+        TestUtils::fail("%s (residente %zu, MADV_FREE %zu, total %zu)", description, stats.residentMemory,
+                        stats.lazyFreeMemory, stats.totalMemory);
+    }
+}
+
+int main()
+{
+    const size_t poolSize = 4 << 20;
+    BuddySystem pool(poolSize);
+
+    // Usar la mitad del pool y dejarla libre
+    unsigned char *block = pool.allocate(poolSize / 2);
+    memset(block, 1, poolSize / 2);
+    pool.deallocate(block);
+
+    BuddySystem::MemoryStats stats = pool.getStats();
+    check(stats.residentMemory == poolSize && stats.lazyFreeMemory == 0, "pool sin recortar", stats);
+
+    #if defined(MADV_FREE)
+    const size_t marked = pool.trim(0, true);
+    stats = pool.getStats();
+    check(marked > 0, "trim con MADV_FREE no marca ninguna página", stats);
+    check(stats.residentMemory == poolSize, "las páginas con MADV_FREE dejan de contar como residentes", stats);
+    check(stats.lazyFreeMemory == marked, "lazyFreeMemory distinto de lo marcado por trim", stats);
+    check(pool.trim(0, true) == 0, "un segundo trim con MADV_FREE vuelve a marcar las mismas páginas", stats);
+
+    // Volver a usar un bloque lo saca de lazyFreeMemory
+    block = pool.allocate(poolSize / 4);
+    memset(block, 2, poolSize / 4);
+    stats = pool.getStats();
+    check(stats.lazyFreeMemory + poolSize / 4 <= marked, "un bloque reutilizado sigue en lazyFreeMemory", stats);
+    check(stats.residentMemory == poolSize, "reutilizar un bloque cambia la memoria residente", stats);
+    pool.deallocate(block);
+    #endif
+
+    // Un trim normal devuelve las páginas (también las marcadas con MADV_FREE)
+    const size_t released = pool.trim(0, false);
+    stats = pool.getStats();
+    check(released > 0 && stats.residentMemory == poolSize - released, "trim normal no descuenta lo liberado", stats);
+    check(stats.lazyFreeMemory == 0, "tras un trim normal quedan páginas con MADV_FREE", stats);
+
+    // Con el pool libre y fusionado en un solo bloque, la reserva caliente guarda
+    // sólo hotReserve bytes de ese bloque y el resto se libera
+    const size_t bigSize = 64 << 20, hotReserve = 1 << 20;
+    BuddySystem merged(bigSize);
+    block = merged.allocate(bigSize / 2);
+    memset(block, 1, bigSize / 2);
+    merged.deallocate(block);
+    const size_t trimmed = merged.trim(hotReserve, false);
+    stats = merged.getStats();
+    check(trimmed == bigSize - hotReserve, "trim con reserva no libera el bloque fusionado más allá de la reserva",
+          stats);
+    check(stats.residentMemory == hotReserve, "trim con reserva no deja residente sólo la reserva", stats);
+
+    return TestUtils::report("test_buddy_trim");
+}
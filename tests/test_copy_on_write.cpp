@@ -0,0 +1,60 @@
+// Copia al escribir: las copias de una imagen comparten el buffer y escribir por
+// las versiones no constantes de pixels(), row() o pixel() sólo cambia la imagen
+// por la que se escribe. Cubre copias, asignaciones y recortes sin copia (crop).
+
+#include "test_utils.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace ImageProcessor;
+using TestUtils::check;
+
+// Escribir en copy por write no puede cambiar original, y copy sí debe cambiar
+template <typename Write>
+static void checkWrite(const char *name, Write write)
+{
+    Image original;
+    TestUtils::makeImage(original, 37, 23, 3, 7);
+    Image reference = original;
+    reference.detach();
+    const unsigned char before = reference.pixel(5, 4)[1];
+
+    Image copy = original;
+    char description[96];
+    std::snprintf(description, sizeof(description), "%s: la copia no comparte el buffer", name);
+    check(copy.isShared() && copy.data == original.data, description);
+    write(copy, (unsigned char)(before + 1));
+
+    std::snprintf(description, sizeof(description), "%s cambia la imagen original", name);
+    check(TestUtils::maxDifference(original, reference) == 0.0, description);
+    std::snprintf(description, sizeof(description), "%s no escribe en la copia", name);
+    check(copy.pixel(5, 4)[1] == (unsigned char)(before + 1), description);
+    std::snprintf(description, sizeof(description), "%s deja la copia compartida", name);
+    check(!copy.isShared() && !original.isShared() && copy.data != original.data, description);
+}
+
+int main()
+{
+    checkWrite("row()", [](Image &image, unsigned char value) { image.row(4)[5 * 3 + 1] = value; });
+    checkWrite("pixel()", [](Image &image, unsigned char value) { image.pixel(5, 4)[1] = value; });
+    checkWrite("pixels()", [](Image &image, unsigned char value) {
+        image.pixels()[4 * image.stride + 5 * 3 + 1] = value;
+    });
+
+    // Leer por las versiones constantes no copia el buffer
+    Image original;
+    TestUtils::makeImage(original, 16, 16, 4, 3);
+    const Image copy = original;
+    const unsigned char *pixel = copy.pixel(3, 3);
+    check(pixel == original.data + 3 * original.stride + 3 * 4 && copy.isShared(), "lectura constante sin copia");
+
+    // Un recorte sin copia comparte el buffer con la imagen de la que sale
+    const Image &source = original;
+    Image crop = source.crop(2, 2, 8, 8);
+    const unsigned char corner = source.pixel(2, 2)[0];
+    crop.pixel(0, 0)[0] = (unsigned char)(corner + 1);
+    check(source.pixel(2, 2)[0] == corner, "escribir en un recorte cambia la imagen original");
+    check(crop.pixel(0, 0)[0] == (unsigned char)(corner + 1), "escribir en un recorte no cambia el recorte");
+
+    return TestUtils::report("test_copy_on_write");
+}
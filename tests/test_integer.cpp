@@ -0,0 +1,77 @@
+// Interpolación con pesos enteros frente a la ruta en float
+// (ImageBase::useIntegerInterpolation): con muestras de 8 y 16 bits, de 1 a 5
+// canales y disposición intercalada o planar, rotar, escalar y rotar y escalar a
+// la vez no pueden diferir en más de 1. Los filtros bicúbico y Lanczos-3 con 16
+// bits usan pesos de 14 bits (ver FilterFixed): su cota es de 8 unidades.
+
+#include "test_utils.h"
+#include <cstdint>
+
+using namespace ImageProcessor;
+
+// Compara ambas rutas en cada operación y filtro sobre source
+template <typename T>
+static void checkImage(const ImageT<T> &source, const char *depthName)
+{
+    const ResampleFilter filters[] = {ResampleFilter::Bilinear, ResampleFilter::Bicubic, ResampleFilter::Lanczos3};
+    struct Case
+    {
+        const char *name;
+        void (*operation)(const ImageT<T> &, ImageT<T> &, ResampleFilter);
+    } cases[] = {
+        {"rotar 30", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.rotateTo(dst, 30.0f, filter);
+         }},
+        {"escalar 1.7", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.scaleTo(dst, 1.7f, filter);
+         }},
+        {"escalar 0.45", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.scaleTo(dst, 0.45f, filter);
+         }},
+        {"rotar y escalar", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.rotateScaleTo(dst, -20.0f, 1.3f, filter);
+         }},
+    };
+
+    for (ResampleFilter filter : filters) {
+        const double tolerance = (sizeof(T) > 1 && filter != ResampleFilter::Bilinear) ? 8.0 : 1.0;
+
+        for (const Case &test : cases) {
+            ImageT<T> integerResult, floatResult;
+            ImageBase::useIntegerInterpolation = true;
+            test.operation(source, integerResult, filter);
+            ImageBase::useIntegerInterpolation = false;
+            test.operation(source, floatResult, filter);
+            ImageBase::useIntegerInterpolation = true;
+
+            const double difference = TestUtils::maxDifference(TestUtils::interleaved(integerResult),
+                                                               TestUtils::interleaved(floatResult));
+            if (difference < 0.0 || difference > tolerance) {
+                TestUtils::fail("%s, %s, %d canales%s, %s: diferencia máxima %g con la ruta en float", test.name,
+                                depthName, source.channels, source.layout == PixelLayout::Planar ? " (planar)" : "",
+                                filterName(filter), difference);
+            }
+        }
+    }
+}
+
+template <typename T>
+static void checkDepth(const char *depthName)
+{
+    for (int channels = 1; channels <= 5; channels++) {
+        ImageT<T> source;
+        TestUtils::makeImage(source, 97, 61, channels, 10 + channels);
+        checkImage(source, depthName);
+
+        source.setLayout(PixelLayout::Planar);
+        checkImage(source, depthName);
+    }
+}
+
+int main()
+{
+    checkDepth<uint8_t>("8 bits");
+    checkDepth<uint16_t>("16 bits");
+
+    return TestUtils::report("test_integer");
+}
@@ -0,0 +1,96 @@
+// Alineación de las imágenes cargadas: loadImage adopta el buffer decodificado sin
+// copiarlo, con el stride del decodificador (width * channels), aunque sus filas no
+// empiecen alineadas a PIXEL_ALIGNMENT bytes. Guarda en PNG imágenes de varios
+// anchos y canales y comprueba, al cargarlas con 8 y 16 bits y float, que no se
+// añade relleno, que los píxeles no cambian y que rotar y escalar la imagen
+// adoptada da lo mismo que con una copia con filas alineadas.
+
+#include "file_io.h"
+#include "test_utils.h"
+#include <cstdint>
+#include <type_traits>
+
+using namespace ImageProcessor;
+
+template <typename T>
+static void checkLoad(const char *path, const Image &saved, const char *depthName)
+{
+    ImageT<T> loaded;
+    if (!FileIO::loadImage(path, loaded)) {
+        TestUtils::fail("no se pudo cargar %s (%s)", path, depthName);
+        return;
+    }
+    if (loaded.width != saved.width || loaded.height != saved.height || loaded.channels != saved.channels) {
+        TestUtils::fail("%dx%d, %d canales, %s: geometría distinta al cargar", saved.width, saved.height,
+                        saved.channels, depthName);
+        return;
+    }
+    if (loaded.stride != (size_t)saved.width * saved.channels) {
+        TestUtils::fail("%dx%d, %d canales, %s: el buffer decodificado no se adopta (stride %zu)", saved.width,
+                        saved.height, saved.channels, depthName, loaded.stride);
+    }
+
+    // Los kernels no suponen filas alineadas: mismo resultado que con una copia
+    // reservada con ensureMemory
+    ImageT<T> aligned;
+    aligned.width = loaded.width;
+    aligned.height = loaded.height;
+    aligned.channels = loaded.channels;
+    aligned.ensureMemory();
+    const ImageT<T> &source = loaded;
+    convertLayout(source.view(), aligned.view());
+    ImageT<T> fromLoaded, fromAligned;
+    source.rotateTo(fromLoaded, 30.0f);
+    aligned.rotateTo(fromAligned, 30.0f);
+    if (TestUtils::maxDifference(fromLoaded, fromAligned) != 0.0) {
+        TestUtils::fail("%dx%d, %d canales, %s: rotar la imagen adoptada no da lo mismo que alineada",
+                        saved.width, saved.height, saved.channels, depthName);
+    }
+    source.scaleTo(fromLoaded, 1.5f);
+    aligned.scaleTo(fromAligned, 1.5f);
+    if (TestUtils::maxDifference(fromLoaded, fromAligned) != 0.0) {
+        TestUtils::fail("%dx%d, %d canales, %s: escalar la imagen adoptada no da lo mismo que alineada",
+                        saved.width, saved.height, saved.channels, depthName);
+    }
+
+    // Las muestras de 8 bits se amplían al rango del tipo al cargar; en float,
+    // stbi_loadf además deshace la gamma (2.2) salvo en el canal alfa
+    const bool hasAlpha = saved.channels % 2 == 0;
+    for (int y = 0; y < saved.height; y++) {
+        for (int x = 0; x < saved.width * saved.channels; x++) {
+            const float normalized = saved.row(y)[x] / 255.0f;
+            const bool alpha = hasAlpha && x % saved.channels == saved.channels - 1;
+            const float expected = std::is_integral<T>::value ? normalized * SampleTraits<T>::white()
+                                   : alpha                    ? normalized
+                                                              : std::pow(normalized, 2.2f);
+            if (std::fabs(loaded.row(y)[x] - expected) > SampleTraits<T>::white() / 255.0f) {
+                TestUtils::fail("%dx%d, %d canales, %s: muestra %d de la fila %d distinta al cargar",
+                                saved.width, saved.height, saved.channels, depthName, x, y);
+                return;
+            }
+        }
+    }
+}
+
+int main()
+{
+    const char *path = "tests/test_load_alignment.png";
+    const int widths[] = {37, 64, 100, 448};
+
+    for (int channels = 1; channels <= 4; channels++) {
+        for (int width : widths) {
+            Image saved;
+            TestUtils::makeImage(saved, width, 19, channels, width + channels);
+            if (!FileIO::saveImage(path, saved)) {
+                TestUtils::fail("no se pudo guardar %s", path);
+                return TestUtils::report("test_load_alignment");
+            }
+            checkLoad<uint8_t>(path, saved, "8 bits");
+            checkLoad<uint16_t>(path, saved, "16 bits");
+            checkLoad<float>(path, saved, "float");
+        }
+    }
+    std::remove(path);
+
+    return TestUtils::report("test_load_alignment");
+}
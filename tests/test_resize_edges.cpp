@@ -0,0 +1,85 @@
+// Bordes del escalado: una imagen de un solo color debe seguir siéndolo tras
+// escalarla o redimensionarla, también en la última fila y la última columna, que
+// al ampliar caen pasado el último píxel de src y deben repetir el borde en lugar
+// de quedar en negro. Cubre ampliaciones enteras y fraccionarias, ejes mixtos (uno
+// se amplía y el otro se reduce), 8 y 16 bits y float, 1, 3 y 4 canales y
+// disposición intercalada y planar, con todos los filtros (el bilineal con algún
+// eje reducido pasa por el promedio de área).
+
+#include "test_utils.h"
+#include <cstdint>
+#include <type_traits>
+
+using namespace ImageProcessor;
+
+template <typename T>
+static void checkImage(const ImageT<T> &source, T value, const char *description)
+{
+    const ResampleFilter filters[] = {ResampleFilter::Nearest, ResampleFilter::Bilinear, ResampleFilter::Bicubic,
+                                      ResampleFilter::Lanczos3};
+    struct Case
+    {
+        const char *name;
+        void (*operation)(const ImageT<T> &, ImageT<T> &, ResampleFilter);
+    } cases[] = {
+        {"escalar 2", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.scaleTo(dst, 2.0f, filter);
+         }},
+        {"escalar 1.5", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.scaleTo(dst, 1.5f, filter);
+         }},
+        {"escalar 2 x 0.5", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.scaleTo(dst, 2.0f, 0.5f, filter);
+         }},
+        {"escalar 0.5 x 2", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.scaleTo(dst, 0.5f, 2.0f, filter);
+         }},
+        {"redimensionar a 25x5", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.resizeTo(dst, 25, 5, filter);
+         }},
+        {"redimensionar a 33x41", [](const ImageT<T> &src, ImageT<T> &dst, ResampleFilter filter) {
+             src.resizeTo(dst, 33, 41, filter);
+         }},
+    };
+    // Con muestras float la normalización de los pesos no es exacta
+    const double tolerance = std::is_integral<T>::value ? 0.0 : 1e-5;
+
+    for (ResampleFilter filter : filters) {
+        for (const Case &test : cases) {
+            ImageT<T> result, expected;
+            test.operation(source, result, filter);
+            TestUtils::makeFlatImage(expected, result.width, result.height, result.channels, value);
+
+            const double difference = TestUtils::maxDifference(TestUtils::interleaved(result), expected);
+            if (difference < 0.0 || difference > tolerance) {
+                TestUtils::fail("%s, %s, %s: diferencia máxima %g con el color de la imagen", test.name, description,
+                                filterName(filter), difference);
+            }
+        }
+    }
+}
+
+template <typename T>
+static void checkDepth(T value, const char *depthName)
+{
+    for (int channels : {1, 3, 4}) {
+        ImageT<T> source;
+        TestUtils::makeFlatImage(source, 10, 8, channels, value);
+        char description[64];
+        std::snprintf(description, sizeof(description), "%s, %d canales", depthName, channels);
+        checkImage(source, value, description);
+
+        source.setLayout(PixelLayout::Planar);
+        std::snprintf(description, sizeof(description), "%s, %d canales (planar)", depthName, channels);
+        checkImage(source, value, description);
+    }
+}
+
+int main()
+{
+    checkDepth<uint8_t>(200, "8 bits");
+    checkDepth<uint16_t>(50000, "16 bits");
+    checkDepth<float>(0.75f, "float");
+
+    return TestUtils::report("test_resize_edges");
+}
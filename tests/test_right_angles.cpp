@@ -0,0 +1,107 @@
+// Giros exactos de 90/180/270 grados (rotateTo con múltiplos de 90) y volteos
+// (flipTo): cada píxel de dst debe ser exactamente el píxel correspondiente de src,
+// con ancho y alto intercambiados en los giros impares. Cubre 8 bits (rutas SSE4.1
+// con 1, 3 y 4 canales), 16 bits y float, de 1 a 5 canales y todas las
+// disposiciones, con tamaños que no son múltiplo de los bloques.
+
+#include "test_utils.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace ImageProcessor;
+
+// Píxel de src que debe acabar en (x, y) de dst tras quarterTurns giros (sentido
+// de AffineTransform::rotation: 90 grados lleva (x, y) a (alto - 1 - y, x))
+static void rotatedSource(int x, int y, int width, int height, int quarterTurns, int &sx, int &sy)
+{
+    switch (quarterTurns) {
+        case 1:  sx = y;             sy = height - 1 - x; break;
+        case 2:  sx = width - 1 - x; sy = height - 1 - y; break;
+        case 3:  sx = width - 1 - y; sy = x;              break;
+        default: sx = x;             sy = y;              break;
+    }
+}
+
+// dst (intercalada) frente a src (intercalada) según la correspondencia source
+template <typename T, typename Mapping>
+static bool samePixels(const ImageT<T> &src, const ImageT<T> &dst, int expectedWidth, int expectedHeight,
+                       Mapping source)
+{
+    if (dst.width != expectedWidth || dst.height != expectedHeight || dst.channels != src.channels) {
+        return false;
+    }
+    for (int y = 0; y < dst.height; y++) {
+        for (int x = 0; x < dst.width; x++) {
+            int sx, sy;
+            source(x, y, sx, sy);
+            if (memcmp(dst.pixel(x, y), src.pixel(sx, sy), sizeof(T) * src.channels) != 0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename T>
+static void checkImage(const ImageT<T> &source, const char *description)
+{
+    const ImageT<T> reference = TestUtils::interleaved(source);
+    const int width = source.width, height = source.height;
+    const float angles[] = {90.0f, 180.0f, 270.0f, -90.0f, 450.0f};
+
+    for (float angle : angles) {
+        const int turns = (((int)angle / 90) % 4 + 4) % 4;
+        ImageT<T> rotated;
+        source.rotateTo(rotated, angle);
+        const bool odd = turns % 2 == 1;
+        if (!samePixels(reference, TestUtils::interleaved(rotated), odd ? height : width, odd ? width : height,
+                        [&](int x, int y, int &sx, int &sy) { rotatedSource(x, y, width, height, turns, sx, sy); })) {
+            TestUtils::fail("girar %g grados, %s", angle, description);
+        }
+    }
+
+    for (int mode = 1; mode <= 3; mode++) {
+        const bool horizontal = (mode & 1) != 0, vertical = (mode & 2) != 0;
+        ImageT<T> flipped;
+        source.flipTo(flipped, horizontal, vertical);
+        if (!samePixels(reference, TestUtils::interleaved(flipped), width, height, [&](int x, int y, int &sx, int &sy) {
+                sx = horizontal ? width - 1 - x : x;
+                sy = vertical ? height - 1 - y : y;
+            })) {
+            TestUtils::fail("voltear%s%s, %s", horizontal ? " horizontal" : "", vertical ? " vertical" : "",
+                            description);
+        }
+    }
+}
+
+template <typename T>
+static void checkDepth(const char *depthName)
+{
+    const PixelLayout layouts[] = {PixelLayout::Interleaved, PixelLayout::Planar, PixelLayout::Tiled,
+                                   PixelLayout::TiledMorton};
+    const char *layoutNames[] = {"intercalada", "planar", "teselas", "Morton"};
+    const int sizes[][2] = {{1, 1}, {7, 3}, {37, 70}, {130, 45}};
+
+    for (int channels = 1; channels <= 5; channels++) {
+        for (const int *size : sizes) {
+            ImageT<T> source;
+            TestUtils::makeImage(source, size[0], size[1], channels, channels * 100 + size[0]);
+            for (int l = 0; l < 4; l++) {
+                source.setLayout(layouts[l]);
+                char description[96];
+                std::snprintf(description, sizeof(description), "%s, %d canales, %dx%d, %s", depthName, channels,
+                              size[0], size[1], layoutNames[l]);
+                checkImage(source, description);
+            }
+        }
+    }
+}
+
+int main()
+{
+    checkDepth<uint8_t>("8 bits");
+    checkDepth<uint16_t>("16 bits");
+    checkDepth<float>("float");
+
+    return TestUtils::report("test_right_angles");
+}
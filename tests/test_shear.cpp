@@ -0,0 +1,100 @@
+// Rotación por tres cizallas (ImageBase::rotationEngine = RotationEngine::Shear)
+// frente a la rotación directa: en una imagen suave, dentro del círculo inscrito
+// (que cae dentro de src con cualquier ángulo) no pueden diferir en más de 2 con
+// 8 bits. Las esquinas de una rotación de 45 grados caen fuera de src y deben
+// tomar exactamente el color de BorderMode::Constant. Cubre los ángulos que pasan
+// por un giro exacto previo, 1, 3 y 4 canales, disposición intercalada y planar, y
+// los filtros con los que rotate usa las cizallas.
+
+#include "test_utils.h"
+#include <cstdint>
+
+using namespace ImageProcessor;
+
+// Mayor diferencia entre a y b (intercaladas) en los píxeles a menos de radius
+// del centro
+static int discDifference(const ImageT<uint8_t> &a, const ImageT<uint8_t> &b, double radius)
+{
+    int worst = 0;
+    const double cx = a.width / 2.0, cy = a.height / 2.0;
+    for (int y = 0; y < a.height; y++) {
+        for (int x = 0; x < a.width; x++) {
+            const double dx = x + 0.5 - cx, dy = y + 0.5 - cy;
+            if (dx * dx + dy * dy > radius * radius) {
+                continue;
+            }
+            for (int c = 0; c < a.channels; c++) {
+                worst = std::max(worst, std::abs((int)a.pixel(x, y)[c] - (int)b.pixel(x, y)[c]));
+            }
+        }
+    }
+    return worst;
+}
+
+static void checkImage(const ImageT<uint8_t> &source, ResampleFilter filter, const char *description)
+{
+    const float angles[] = {7.0f, 30.0f, 45.0f, -38.0f, 100.0f, 200.0f, -135.0f};
+    const double radius = std::min(source.width, source.height) / 2.0 - 6.0;
+
+    for (float angle : angles) {
+        ImageT<uint8_t> direct, shear;
+        ImageBase::rotationEngine = RotationEngine::Direct;
+        source.rotateTo(direct, angle, filter);
+        ImageBase::rotationEngine = RotationEngine::Shear;
+        source.rotateTo(shear, angle, filter);
+        ImageBase::rotationEngine = RotationEngine::Direct;
+
+        const ImageT<uint8_t> directPixels = TestUtils::interleaved(direct);
+        const ImageT<uint8_t> shearPixels = TestUtils::interleaved(shear);
+        if (shearPixels.width != directPixels.width || shearPixels.height != directPixels.height) {
+            TestUtils::fail("girar %g grados, %s: tamaño distinto de la rotación directa", angle, description);
+            continue;
+        }
+        const int difference = discDifference(directPixels, shearPixels, radius);
+        if (difference > 2) {
+            TestUtils::fail("girar %g grados, %s: diferencia máxima %d con la rotación directa", angle,
+                            description, difference);
+        }
+
+        // Las cuatro esquinas de un giro de 45 grados quedan fuera de src
+        if (angle == 45.0f) {
+            const int corners[][2] = {{0, 0}, {shearPixels.width - 1, 0}, {0, shearPixels.height - 1},
+                                      {shearPixels.width - 1, shearPixels.height - 1}};
+            for (const int *corner : corners) {
+                const uint8_t *pixel = shearPixels.pixel(corner[0], corner[1]);
+                for (int c = 0; c < source.channels; c++) {
+                    const uint8_t expected = (uint8_t)(ImageBase::borderColor[std::min(c, 3)] * 255.0f + 0.5f);
+                    if (pixel[c] != expected) {
+                        TestUtils::fail("girar 45 grados, %s: esquina (%d, %d) = %d en lugar de %d",
+                                        description, corner[0], corner[1], pixel[c], expected);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+int main()
+{
+    const ResampleFilter filters[] = {ResampleFilter::Bilinear, ResampleFilter::Bicubic, ResampleFilter::Lanczos3};
+    const float borderColor[4] = {0.2f, 0.6f, 1.0f, 0.4f};
+    std::copy(borderColor, borderColor + 4, ImageBase::borderColor);
+
+    for (int channels : {1, 3, 4}) {
+        ImageT<uint8_t> source;
+        TestUtils::makeSmoothImage(source, 181, 117, channels);
+        for (ResampleFilter filter : filters) {
+            char description[96];
+            std::snprintf(description, sizeof(description), "%d canales, %s", channels, filterName(filter));
+            checkImage(source, filter, description);
+
+            source.setLayout(PixelLayout::Planar);
+            std::snprintf(description, sizeof(description), "%d canales (planar), %s", channels, filterName(filter));
+            checkImage(source, filter, description);
+            source.setLayout(PixelLayout::Interleaved);
+        }
+    }
+
+    return TestUtils::report("test_shear");
+}
@@ -0,0 +1,75 @@
+// Kernels bilineales vectoriales frente a BilinearSimd::referenceRow: en cada nivel
+// que admite la CPU (hasta detectLevel()) y con 3 y 4 canales, la salida debe ser
+// idéntica bit a bit para posiciones, pasos (también negativos y nulos) y
+// longitudes de fila aleatorias, incluidas las colas que no llenan un registro y
+// las posiciones fuera de la imagen. Tampoco pueden escribir más allá de n píxeles.
+
+#include "bilinear_simd.h"
+#include "test_utils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using BilinearSimd::Level;
+
+// Entero aleatorio en [lo, hi]
+static int randomInt(int lo, int hi)
+{
+    return lo + rand() % (hi - lo + 1);
+}
+
+int main()
+{
+    const Level detected = BilinearSimd::detectLevel();
+    const Level levels[] = {Level::SSE41, Level::AVX2, Level::AVX512};
+    const int GUARD = 64; // Bytes de control tras la fila de salida
+    int checked = 0;
+
+    srand(42);
+    for (Level level : levels) {
+        if (level > detected) {
+            std::printf("test_simd: %s no disponible en esta CPU\n", BilinearSimd::levelName(level));
+            continue;
+        }
+
+        for (int channels = 3; channels <= 4; channels++) {
+            const BilinearSimd::RowKernel kernel = BilinearSimd::rowKernel(level, channels);
+            if (!kernel) {
+                TestUtils::fail("%s sin kernel para %d canales", BilinearSimd::levelName(level), channels);
+                continue;
+            }
+
+            for (int iteration = 0; iteration < 2000; iteration++) {
+                const int width = randomInt(2, 80), height = randomInt(2, 60);
+                const int stride = width * channels + randomInt(0, 9);
+                std::vector<uint8_t> src((size_t)stride * height);
+                for (uint8_t &sample : src) {
+                    sample = (uint8_t)rand();
+                }
+
+                // Posición inicial y paso en 16.16: cerca de la imagen, a veces fuera
+                const int32_t fx = randomInt(-3 * width, 4 * width) * 16384 + randomInt(0, 16383);
+                const int32_t fy = randomInt(-3 * height, 4 * height) * 16384 + randomInt(0, 16383);
+                const int32_t stepX = (iteration % 7 == 0) ? 0 : randomInt(-3 * 65536, 3 * 65536);
+                const int32_t stepY = (iteration % 11 == 0) ? 0 : randomInt(-3 * 65536, 3 * 65536);
+                const int n = randomInt(1, 70);
+
+                std::vector<uint8_t> expected((size_t)n * channels + GUARD, 0xA5);
+                std::vector<uint8_t> actual((size_t)n * channels + GUARD, 0xA5);
+                BilinearSimd::referenceRow(src.data(), stride, width, height, channels, fx, fy, stepX, stepY, n,
+                                           expected.data());
+                kernel(src.data(), stride, width, height, fx, fy, stepX, stepY, n, actual.data());
+                checked++;
+
+                if (memcmp(expected.data(), actual.data(), actual.size()) != 0) {
+                    TestUtils::fail("%s, %d canales, %dx%d, fx=%d fy=%d paso=(%d, %d) n=%d",
+                                    BilinearSimd::levelName(level), channels, width, height, fx, fy, stepX, stepY, n);
+                }
+            }
+        }
+    }
+
+    std::printf("test_simd: %d filas comprobadas\n", checked);
+    return TestUtils::report("test_simd");
+}
@@ -0,0 +1,137 @@
+// Utilidades comunes de las pruebas de tests/
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+#include "image_processor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace TestUtils
+{
+    // Imagen de width x height con channels canales: degradado suave más ruido, con
+    // valores repartidos por todo el rango del tipo de muestra
+    template <typename T>
+    void makeImage(ImageProcessor::ImageT<T> &image, int width, int height, int channels, unsigned seed = 1)
+    {
+        srand(seed);
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        image.allocateMemory();
+        const float white = ImageProcessor::SampleTraits<T>::white();
+        for (int y = 0; y < height; y++) {
+            T *row = image.row(y);
+            for (int x = 0; x < width * channels; x++) {
+                const float smooth = 0.5f + 0.4f * std::sin(0.05f * x + 0.07f * y);
+                const float noise = (rand() % 1000) / 1000.0f * 0.2f - 0.1f;
+                row[x] = ImageProcessor::SampleTraits<T>::fromFloat(std::min(1.0f, std::max(0.0f, smooth + noise)) * white);
+            }
+        }
+    }
+
+    // Degradado suave sin ruido ni detalles finos, distinto en cada canal (para
+    // comparar métodos que sólo coinciden en zonas suaves)
+    template <typename T>
+    void makeSmoothImage(ImageProcessor::ImageT<T> &image, int width, int height, int channels,
+                         bool useBuddySystem = false)
+    {
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        image.allocateMemory(useBuddySystem);
+        const float white = ImageProcessor::SampleTraits<T>::white();
+        for (int y = 0; y < height; y++) {
+            T *row = image.row(y);
+            for (int x = 0; x < width; x++) {
+                for (int c = 0; c < channels; c++) {
+                    const float smooth = 0.5f + 0.39f * std::sin(0.03f * x + 0.02f * y + c);
+                    row[x * channels + c] = ImageProcessor::SampleTraits<T>::fromFloat(smooth * white);
+                }
+            }
+        }
+    }
+
+    // Imagen de un solo valor en todas las muestras
+    template <typename T>
+    void makeFlatImage(ImageProcessor::ImageT<T> &image, int width, int height, int channels, T value)
+    {
+        image.width = width;
+        image.height = height;
+        image.channels = channels;
+        image.allocateMemory();
+        for (int y = 0; y < height; y++) {
+            std::fill(image.row(y), image.row(y) + width * channels, value);
+        }
+    }
+
+    // Mayor diferencia absoluta entre dos imágenes de la misma geometría (en
+    // disposición intercalada); -1 si la geometría no coincide
+    template <typename T>
+    double maxDifference(const ImageProcessor::ImageT<T> &a, const ImageProcessor::ImageT<T> &b)
+    {
+        if (a.width != b.width || a.height != b.height || a.channels != b.channels) {
+            return -1.0;
+        }
+        double worst = 0.0;
+        for (int y = 0; y < a.height; y++) {
+            for (int x = 0; x < a.width * a.channels; x++) {
+                worst = std::max(worst, std::fabs((double)a.row(y)[x] - (double)b.row(y)[x]));
+            }
+        }
+        return worst;
+    }
+
+    // Copia intercalada (para comparar imágenes en cualquier disposición)
+    template <typename T>
+    ImageProcessor::ImageT<T> interleaved(const ImageProcessor::ImageT<T> &image)
+    {
+        ImageProcessor::ImageT<T> copy = image;
+        copy.setLayout(ImageProcessor::PixelLayout::Interleaved);
+        return copy;
+    }
+
+    // Comprobaciones fallidas del programa de prueba
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    // Informa de un fallo (con formato de printf) y lo cuenta
+    inline void fail(const char *format, ...) __attribute__((format(printf, 1, 2)));
+    inline void fail(const char *format, ...)
+    {
+        va_list arguments;
+        va_start(arguments, format);
+        std::printf("FALLO: ");
+        std::vprintf(format, arguments);
+        std::printf("\n");
+        va_end(arguments);
+        failures()++;
+    }
+
+    // Cuenta un fallo con description si condition no se cumple
+    inline bool check(bool condition, const char *description)
+    {
+        if (!condition) {
+            fail("%s", description);
+        }
+        return condition;
+    }
+
+    // Resumen final de la prueba name; el valor se devuelve desde main
+    inline int report(const char *name)
+    {
+        if (failures() > 0) {
+            std::printf("%s: %d comprobaciones fallidas\n", name, failures());
+            return 1;
+        }
+        std::printf("%s: OK\n", name);
+        return 0;
+    }
+}
+
+#endif